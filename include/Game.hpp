@@ -10,13 +10,28 @@ class Game {
     GameLogic gameLogic;
     PlayerView playerView;
 
+    // Number of fixed-length game ticks run per second, independent of the framerate
+    int tickRate = DEFAULT_TICK_RATE;
+
     public:
+    // Game ticks per second unless changed with setTickRate
+    static const int DEFAULT_TICK_RATE = 60;
+
     Game() : gameLogic(), playerView(*this) {}
 
     GameLogic& getGameLogic() {
         return gameLogic;
     }
 
+    int getTickRate() const {
+        return tickRate;
+    }
+
+    // Rates below 1 would make a tick infinitely (or negatively) long, so they are clamped to 1
+    void setTickRate(int rate) {
+        tickRate = rate < 1 ? 1 : rate;
+    }
+
     void run();
 };
 
@@ -5,14 +5,21 @@
 #include "levels/LevelData.hpp"
 #include "GameState.hpp"
 #include "TimeKeeper.hpp"
+#include "TimerWheel.hpp"
 
 #include <memory>
 
 class Player;
 class Enemy;
 
+// Distance (pixels) past either edge of the screen that entities keep being simulated, anything further away sleeps
+const double DEFAULT_ACTIVITY_MARGIN = 256;
+
 class GameLogic {
     private:
+    // Gameplay timers, advanced by runTick. Declared first so it outlives everything that cancels timers on destruction
+    std::shared_ptr<TimerWheel> timerWheel;
+
     std::shared_ptr<Player> player;
     std::shared_ptr<TimeKeeper> timer;
     
@@ -27,6 +34,11 @@ class GameLogic {
     // Index of the active level
     int levelIndex = 0;
 
+    // How far (0 to 1) the current frame is between the last two game ticks
+    double interpolation = 1;
+
+    double activityMargin = DEFAULT_ACTIVITY_MARGIN;
+
     // TODO: Replace with actual levels
     std::array<LevelData, 5> levelData;
 
@@ -40,6 +52,10 @@ class GameLogic {
     std::shared_ptr<TimeKeeper> getTimer() {
         return timer;
     }
+
+    std::shared_ptr<TimerWheel> getTimerWheel() {
+        return timerWheel;
+    }
    
     std::shared_ptr<Level> getLevel() {
         return level;
@@ -77,13 +93,29 @@ class GameLogic {
         levelIndex = index;
     }
 
+    double getInterpolation() const {
+        return interpolation;
+    }
+
+    void setInterpolation(double _interpolation) {
+        interpolation = _interpolation;
+    }
+
+    double getActivityMargin() const {
+        return activityMargin;
+    }
+
+    void setActivityMargin(double margin) {
+        activityMargin = margin;
+    }
+
     // Setup function
     void init();
 
     // Runs a game tick lasting this many milliseconds
     void runTick(double ms);
 
-    // Gets the current horizontal offset for the camera for scrolling
+    // Gets the current horizontal offset for the camera for scrolling (follows the interpolated player position)
     double getScrollOffset() const;
 
     // Sets up the game to be active
@@ -0,0 +1,81 @@
+#ifndef _HANDLE_TABLE_H
+#define _HANDLE_TABLE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Refers to an entry in a container that uses a HandleTable. A handle keeps referring to the same entry while others
+// are added or removed, and becomes stale (instead of pointing at a different entry) once its entry is removed.
+struct Handle {
+    uint32_t slot = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const Handle& other) const {
+        return slot == other.slot && generation == other.generation;
+    }
+};
+
+// Maps generational handles to the dense indexes of a container that stores its entries contiguously.
+// Entries are removed by moving the last entry into their place, so dense indexes are only good for the current tick.
+class HandleTable {
+    private:
+    // Handle slot for each dense index
+    std::vector<uint32_t> denseSlots;
+
+    // Dense index and generation for each handle slot, along with the unused slots
+    std::vector<uint32_t> slotIndexes;
+    std::vector<uint32_t> slotGenerations;
+    std::vector<uint32_t> freeSlots;
+
+    // Frees the slot at a dense index and moves the last slot into its place (the caller moves the entry itself)
+    void remove(size_t index);
+
+    public:
+    // Makes room for this many entries, so adding up to that many (and removing them) doesn't allocate
+    void reserve(size_t capacity);
+
+    // Gives a handle to a new entry at the dense index size()
+    Handle add();
+
+    // Removes every entry that isDead(index) returns true for, in a single pass over the container.
+    // moveEntry(from, to) must move the container's entry from one dense index to another, afterwards the
+    // container should drop everything past size().
+    template <typename IsDead, typename MoveEntry>
+    void compact(IsDead isDead, MoveEntry moveEntry) {
+        // Go backwards so that the entries swapped into removed spots have already been checked
+        for (size_t idx = size(); idx-- > 0;) {
+            if (isDead(idx)) {
+                size_t last = size() - 1;
+
+                if (idx != last) {
+                    moveEntry(last, idx);
+                }
+
+                remove(idx);
+            }
+        }
+    }
+
+    // Removes every entry, making all of their handles stale
+    void clear();
+
+    size_t size() const {
+        return denseSlots.size();
+    }
+
+    bool isValid(Handle handle) const {
+        return handle.slot < slotGenerations.size() && slotGenerations[handle.slot] == handle.generation && slotIndexes[handle.slot] != UINT32_MAX;
+    }
+
+    // Dense index of a valid handle
+    size_t indexOf(Handle handle) const {
+        return slotIndexes[handle.slot];
+    }
+
+    Handle handleAt(size_t index) const {
+        return Handle { denseSlots[index], slotGenerations[denseSlots[index]] };
+    }
+};
+
+#endif
@@ -2,36 +2,50 @@
 #define _PROJECTILE_H
 
 #include "physics/Vector2.hpp"
-#include "MoveDirection.hpp"
-#include "GameLogic.hpp"
-#include <memory>
+#include "physics/BoundingBox.hpp"
+#include "characters/EntityStore.hpp"
+#include "mathutils.hpp"
+#include "levels/WorldQuery.hpp"
 
+// Speed of every projectile in pixels per second
+const double PROJECTILE_SPEED = 300;
+
+// Distance a projectile can travel before disappearing
+const double PROJECTILE_RANGE = 500;
+
+// Who fired a projectile, player projectiles hurt enemies and enemy projectiles hurt the player
+enum class ProjectileOwner {
+    PLAYER,
+    ENEMY
+};
+
+// A single player or enemy projectile, stored by value in the level's ProjectilePool
 class Projectile {
 
     private:
-        // Apparently push_back does not work when a member variable is a reference, so I switched it to a pointer
-        std::shared_ptr<GameLogic> gameLogic;
+        Vector2 currentPosition, velocity;
 
-        Vector2 currentPosition, velocity, startingPosition;
-        bool active = false;
+        // Position at the start of the current game tick, used to smooth out drawing between ticks
+        Vector2 previousPosition;
 
-        // holds the current direction of the projectile, will be assigned players current direction
-        MoveDirection currentDirection;
+        double distanceTraveled = 0;
+        bool active = true;
+
+        ProjectileOwner owner;
+
+        // Enemy that fired the projectile (stale for player projectiles)
+        EntityHandle shooter;
 
         BoundingBox hitbox = BoundingBox(Vector2(-7, -9), Vector2(14, 18));
     public:
-        Projectile(std::shared_ptr<GameLogic> _gameLogic, Vector2 playerPosition, MoveDirection playerDirection);
+        Projectile(ProjectileOwner _owner, Vector2 position, Vector2 _velocity, EntityHandle _shooter = EntityHandle());
 
         const Vector2& getPosition() const {
             return currentPosition;
         }
 
-        MoveDirection getCurrentDirection() const {
-            return currentDirection;
-        }
-
-        const Vector2& getStartingPosition() const {
-            return startingPosition;
+        Vector2 getInterpolatedPosition(double interpolation) const {
+            return mathutils::lerp(previousPosition, currentPosition, interpolation);
         }
 
         const Vector2& getVelocity() const {
@@ -42,23 +56,28 @@ class Projectile {
             return hitbox;
         }
 
+        ProjectileOwner getOwner() const {
+            return owner;
+        }
+
+        EntityHandle getShooter() const {
+            return shooter;
+        }
+
         void setActive(bool activity) {
             active = activity;
         }
 
-        bool isActive() {
+        bool isActive() const {
             return active;
         }
 
-        void setStartingPosition(MoveDirection direction);
-        void setVelocity(double x, double y);
-        
-        virtual void move(double ms);
-
-        void setDirection(MoveDirection direction) {
-            currentDirection = direction;
+        bool isMovingLeft() const {
+            return velocity.getX() < 0;
         }
 
+        // Moves the projectile, stopping it at walls and (for player projectiles) hurting the first enemy it hits
+        void move(WorldQuery& world, double ms);
 };
 
 #endif
\ No newline at end of file
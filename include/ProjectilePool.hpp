@@ -0,0 +1,68 @@
+#ifndef _PROJECTILE_POOL_H
+#define _PROJECTILE_POOL_H
+
+#include "Projectile.hpp"
+#include "HandleTable.hpp"
+
+#include <vector>
+
+// Most projectiles (from the player and every enemy together) that can be in a level at once
+const size_t PROJECTILE_POOL_CAPACITY = 256;
+
+// Refers to a projectile in a ProjectilePool
+using ProjectileHandle = Handle;
+
+// Every projectile in the level, stored contiguously.
+// The storage (and the handle table's) is reserved up front, so firing and removing projectiles never allocates.
+class ProjectilePool {
+    private:
+    std::vector<Projectile> projectiles;
+    HandleTable handles;
+
+    public:
+    ProjectilePool() {
+        projectiles.reserve(PROJECTILE_POOL_CAPACITY);
+        handles.reserve(PROJECTILE_POOL_CAPACITY);
+    }
+
+    // Adds a projectile, returns a stale handle if the pool is full
+    ProjectileHandle spawn(const Projectile& projectile);
+
+    // Number of active projectiles fired by the owner (and for enemies, by that specific enemy)
+    size_t countOwnedBy(ProjectileOwner owner, EntityHandle shooter = EntityHandle()) const;
+
+    // Moves every active projectile
+    void update(WorldQuery& world, double ms);
+
+    // Removes the projectiles that stopped during the tick (swapping the last projectile into their place)
+    void compact();
+
+    void clear();
+
+    size_t size() const {
+        return projectiles.size();
+    }
+
+    bool isValid(ProjectileHandle handle) const {
+        return handles.isValid(handle);
+    }
+
+    // Dense index of a valid handle
+    size_t indexOf(ProjectileHandle handle) const {
+        return handles.indexOf(handle);
+    }
+
+    ProjectileHandle handleAt(size_t index) const {
+        return handles.handleAt(index);
+    }
+
+    Projectile& operator[](size_t index) {
+        return projectiles[index];
+    }
+
+    const Projectile& operator[](size_t index) const {
+        return projectiles[index];
+    }
+};
+
+#endif
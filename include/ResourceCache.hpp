@@ -0,0 +1,91 @@
+#ifndef _RESOURCE_CACHE_H
+#define _RESOURCE_CACHE_H
+
+#include "SDL.h"
+#include "SDL_image.h"
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <tuple>
+
+// Identifies a decoded image: the file, the pixel format it was converted to and how much it was scaled
+struct ResourceKey {
+    std::string path;
+    Uint32 format;
+    double scale;
+
+    bool operator<(const ResourceKey& other) const {
+        return std::tie(path, format, scale) < std::tie(other.path, other.format, other.scale);
+    }
+};
+
+// ResourceCache decodes each image once and uploads it once, then hands out shared handles to the result.
+// Entries stay loaded after the last handle is dropped, so switching screens or restarting a level does no decoding.
+// Textures and surfaces nothing holds count towards the TextureResidency budget and can be freed by it. A freed texture is
+// uploaded again from its surface when next asked for, and a freed surface is decoded from its file again.
+class ResourceCache {
+    private:
+    static ResourceCache* instance;
+
+    SDL_Renderer* renderer = nullptr;
+
+    struct SurfaceEntry {
+        std::shared_ptr<SDL_Surface> surface;
+        unsigned int requests = 0;
+
+        // Set when the surface was freed to stay within the budget
+        bool evicted = false;
+    };
+
+    struct TextureEntry {
+        std::shared_ptr<SDL_Texture> texture;
+        int width = 0;
+        int height = 0;
+        unsigned int requests = 0;
+
+        // Set when the texture was freed to stay within the texture budget
+        bool evicted = false;
+    };
+
+    std::map<ResourceKey, SurfaceEntry> surfaces;
+    std::map<ResourceKey, TextureEntry> textures;
+
+    // Number of images decoded and textures created since the cache was initialized
+    unsigned int decodes = 0;
+    unsigned int uploads = 0;
+
+    ResourceCache() {}
+
+    // Decodes an image from disk, converted to the format and scaled (nullptr if it couldn't be loaded)
+    SDL_Surface* decode(const ResourceKey& key);
+
+    // Decodes the surface of an entry, and registers it with TextureResidency
+    void load(const ResourceKey& key, SurfaceEntry& entry);
+
+    // Creates the texture of an entry from its cached surface, and registers it with TextureResidency
+    void upload(const ResourceKey& key, TextureEntry& entry);
+
+    public:
+    static ResourceCache* getInstance();
+
+    // Sets the renderer textures are uploaded to
+    void initialize(SDL_Renderer* _renderer);
+
+    // The decoded pixels of an image (nullptr if it couldn't be loaded)
+    std::shared_ptr<SDL_Surface> getSurface(const std::string& path, Uint32 format = SDL_PIXELFORMAT_RGBA32, double scale = 1.0);
+
+    // A texture of an image (nullptr if it couldn't be loaded)
+    std::shared_ptr<SDL_Texture> getTexture(const std::string& path, Uint32 format = SDL_PIXELFORMAT_RGBA32, double scale = 1.0);
+
+    // Writes every loaded image, its size, how many handles to it are held and how often it was asked for
+    void printResidencyReport(std::ostream& out) const;
+
+    // Frees everything (handles still held elsewhere keep their resource alive until they are dropped)
+    void cleanup();
+
+    ~ResourceCache();
+};
+
+#endif
@@ -0,0 +1,82 @@
+#ifndef _TEXTURE_RESIDENCY_H
+#define _TEXTURE_RESIDENCY_H
+
+#include <cstddef>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Bytes of texture (and decoded image) memory kept before ones that weren't used recently start being freed
+const size_t DEFAULT_TEXTURE_BUDGET = 128 * 1024 * 1024;
+
+// TextureResidency keeps the textures the game has uploaded, and the decoded images they come from, within a byte budget.
+// Owners register their textures along with a way to free them, and mark them as used whenever they are drawn.
+// At the end of every frame, if the budget is exceeded, the least recently used textures that weren't drawn
+// that frame are freed until it isn't. Owners re-create freed textures (from surfaces they kept, by rendering them again, or by decoding the file again) the next time they need them.
+class TextureResidency {
+    private:
+    static TextureResidency* instance;
+
+    struct Resident {
+        size_t bytes;
+        unsigned long lastUsedFrame;
+
+        // Frees the texture (without calling remove), returning false if it can't be freed right now (pinned textures don't have one)
+        std::function<bool()> evict;
+    };
+
+    std::unordered_map<const void*, Resident> residents;
+
+    size_t budget = DEFAULT_TEXTURE_BUDGET;
+    size_t residentBytes = 0;
+
+    unsigned long frame = 0;
+    unsigned int evictions = 0;
+
+    // Textures that could be freed, by the frame they were last used in (kept between frames so it doesn't allocate)
+    std::vector<std::pair<unsigned long, const void*>> candidates;
+
+    // Set with residentBytes when a pass couldn't get under the budget, nothing is tried again until a texture is added or freed
+    bool overBudget = false;
+    size_t overBudgetBytes = 0;
+
+    TextureResidency() {}
+
+    // Frees least recently used textures until the budget is met (or nothing else can be freed)
+    void enforceBudget();
+
+    public:
+    static TextureResidency* getInstance();
+
+    void setBudget(size_t bytes) {
+        budget = bytes;
+        overBudget = false;
+    }
+
+    size_t getBudget() const {
+        return budget;
+    }
+
+    size_t getResidentBytes() const {
+        return residentBytes;
+    }
+
+    unsigned int getEvictions() const {
+        return evictions;
+    }
+
+    // Registers a texture (the key only identifies it). Without an evict function it is never freed, but still counts towards the budget.
+    void add(const void* key, size_t bytes, std::function<bool()> evict = nullptr);
+
+    // Marks a texture as drawn this frame
+    void touch(const void* key);
+
+    // Unregisters a texture its owner freed itself
+    void remove(const void* key);
+
+    // Frees textures if needed and starts the next frame, call this once the frame has been drawn
+    void endFrame();
+};
+
+#endif
@@ -2,36 +2,71 @@
 #define _TIMEKEEPER_H
 
 #include <SDL.h>
+#include <functional>
 #include <iostream>
 #include <string>
+#include <vector>
 
+// Seconds left when the clock starts warning the player
+const int WARNING_TIME = 10;
+
+// How long (ms) the clock shows a warning after the player loses time
+const double PENALTY_WARNING_LENGTH = 2000;
+
+// Things that can happen to the countdown
+enum class TimeEvent {
+    WARNING, // The countdown reached WARNING_TIME
+    PENALTY, // Time was subtracted (seconds is the amount lost)
+    TIME_UP // The countdown reached 0
+};
+
+// Called with the event and the number of seconds involved
+using TimeListener = std::function<void(TimeEvent event, int seconds)>;
+
+// Level countdown, driven by the game ticks so it stops whenever the game does
 class TimeKeeper {
 
     private:
-        int minutes, seconds, startTime, endTime;
-        int timeElapsed;
+        int minutes, seconds, startTime;
+
+        // Time left in ms
+        double timeLeft;
         bool timeRunning;
 
-        int iterations = 0; // This is used so that we can update the timer more frequently in case the player gets hit.
+        // Time left (ms) on the warning shown after a penalty
+        double penaltyWarning = 0;
 
-        bool isWarning = false;
-        int warnTime = 60;
-        bool playedWarnSound = false;
+        bool sentWarning = false;
+        bool sentTimeUp = false;
+
+        std::vector<TimeListener> listeners;
+
+        // Updates the minutes and seconds shown from the time left, sending any events that were crossed
+        void updateDisplay();
+
+        void notify(TimeEvent event, int eventSeconds);
 
     public:
         TimeKeeper(); // initialize the time 
         void pauseTimer() {timeRunning = false;}
-        void resetTimer(); // set reset timer by setting the startime to the current time
-        void beginTimer(); // updates the time in the gameloop
+        void startTimer() {timeRunning = true;}
+
+        // Counts down by this many ms of game time
+        void update(double ms);
 
          // Subtracts seconds from the timer
         void subtractTime(int _seconds);
 
+        // Listens for countdown events
+        void addListener(TimeListener listener) {
+            listeners.push_back(listener);
+        }
+
         bool getIsWarning() const {
-            return isWarning;
+            return seconds + minutes * 60 <= WARNING_TIME || penaltyWarning > 0;
         }
 
-        bool isTimeUp() const { return timeElapsed <= 0; } // check if the time is up
+        bool isTimeUp() const { return timeLeft <= 0; } // check if the time is up
 
         std::string getTime() const;
     
@@ -0,0 +1,90 @@
+#ifndef _TIMER_WHEEL_H
+#define _TIMER_WHEEL_H
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Number of wheels, each one covering TIMER_WHEEL_SLOTS times the range of the one below it
+const int TIMER_WHEEL_LEVELS = 4;
+
+// Slots per wheel (must be a power of 2), the bottom wheel has a 1 ms resolution
+const int TIMER_WHEEL_SLOT_BITS = 6;
+const int TIMER_WHEEL_SLOTS = 1 << TIMER_WHEEL_SLOT_BITS;
+
+// Refers to a scheduled timer. The generation makes a handle stale once its timer fires or is cancelled,
+// so an old handle can never cancel a newer timer that reuses the same slot.
+struct TimerHandle {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+// Hierarchical timer wheel for gameplay timers (cooldowns, invincibility, speed effects, ...).
+// Time only moves forward when advance() is called, so timers run on the main thread, stop while the game is paused,
+// and scheduling, cancelling or extending a timer takes constant time.
+class TimerWheel {
+    private:
+    struct Timer {
+        uint64_t expiry = 0; // Time (ms) at which the timer fires
+        std::function<void()> callback;
+
+        // Doubly linked list of the timers in the same slot
+        int32_t prev = -1;
+        int32_t next = -1;
+        int32_t slot = -1; // -1 if the timer is not scheduled
+
+        uint32_t generation = 0;
+    };
+
+    std::vector<Timer> timers;
+    std::vector<uint32_t> freeTimers;
+
+    // First timer in each slot of each wheel (-1 if empty)
+    int32_t slotHeads[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS];
+
+    // Current time in whole ms, along with the fraction of a ms that has not been counted yet
+    uint64_t currentTime = 0;
+    double remainder = 0;
+
+    // Puts a timer into the slot matching its expiry
+    void link(uint32_t index);
+    void unlink(uint32_t index);
+
+    // Frees a timer, making all of its handles stale
+    void release(uint32_t index);
+
+    // Moves the clock forward by 1 ms, firing any timers that expire
+    void step();
+
+    bool isValid(TimerHandle handle) const;
+
+    public:
+    TimerWheel();
+
+    // Calls the callback once delay ms of game time have passed
+    TimerHandle schedule(double delay, std::function<void()> callback);
+
+    // Stops a timer from firing, returns false if it already fired or was cancelled
+    bool cancel(TimerHandle handle);
+
+    // Restarts a timer so that it fires delay ms from now, returns false if it already fired or was cancelled
+    bool extend(TimerHandle handle, double delay);
+
+    // Checks if the timer is still waiting to fire
+    bool isActive(TimerHandle handle) const {
+        return isValid(handle);
+    }
+
+    // Runs the clock forward this many milliseconds
+    void advance(double ms);
+
+    // Cancels every timer
+    void clear();
+
+    // Number of whole ms the wheel has been advanced by
+    uint64_t getTime() const {
+        return currentTime;
+    }
+};
+
+#endif
@@ -2,18 +2,32 @@
 #define _CHARACTER_H
 
 #include "physics/Vector2.hpp"
+#include "mathutils.hpp"
 
 class Character {
     protected:
     Vector2 position, velocity; // Velocity unit is in pixels per second, position refers to the center
+
+    // Position at the start of the current game tick, used to smooth out drawing between ticks
+    Vector2 previousPosition;
         
     public:
-    Character(Vector2 _position) : position(_position), velocity(Vector2(0, 0)) {}
+    Character(Vector2 _position) : position(_position), velocity(Vector2(0, 0)), previousPosition(_position) {}
 
     const Vector2& getPosition() const {
         return position;
     }
 
+    // Gets the position to draw at, given how far (0 to 1) rendering is between the previous tick and the current one
+    Vector2 getInterpolatedPosition(double interpolation) const {
+        return mathutils::lerp(previousPosition, position, interpolation);
+    }
+
+    // Remembers the current position before a new tick runs
+    void savePreviousPosition() {
+        previousPosition = position;
+    }
+
     const Vector2& getVelocity() const {
         return velocity;
     }
@@ -1,75 +1,54 @@
 #ifndef _CORGI_HPP
 #define _CORGI_HPP
-#include "Character.hpp"
+#include "characters/EntityStore.hpp"
 #include "MoveDirection.hpp"
+#include "mathutils.hpp"
 #include "physics/Vector2.hpp"
 #include "physics/BoundingBox.hpp"
 
 const int CORGI_WIDTH = 32;
 const int CORGI_HEIGHT = 64;
 
-class Corgi : public Character {
+// corgi hitbox dimensions
+const BoundingBox CORGI_HITBOX = BoundingBox(Vector2(-16, 0), Vector2(32, 19));
 
-    private:
-        // Set initial direction
-        MoveDirection currentDirection = MoveDirection::RIGHT;
-
-        // Last direction moved
-        MoveDirection lastDirection = MoveDirection::RIGHT;
-
-        int animationTicks = 0;
-
-        // corgi hitbox dimensions
-        BoundingBox hitbox = BoundingBox(Vector2(-16, 0), Vector2(32, 19));
+// View of a single corgi in the level's corgi EntityStore
+class Corgi {
 
-        // Track the corgi moves on
-        double trackStart, trackEnd;
+    private:
+        EntityStore& store;
+        size_t index;
 
-        // y-level of the ground
-        double groundLevel = 576;
+    public:
+        Corgi(EntityStore& _store, size_t _index) : store(_store), index(_index) {}
 
-        // Texture offset for the CORGI (can be either 0 or 2 for now)
-        int textureOffset = 0;
+        const Vector2& getPosition() const {
+            return store.positions[index];
+        }
 
-    public:
-        Corgi(Vector2 _position, double _trackStart, double _trackEnd) : Character(_position), trackStart(_trackStart), trackEnd(_trackEnd) {
-            velocity.setX(120);
-            textureOffset = rand() % 2 == 0 ? 0 : 2;
+        Vector2 getInterpolatedPosition(double interpolation) const {
+            return mathutils::lerp(store.previousPositions[index], store.positions[index], interpolation);
         }
 
         MoveDirection getCurrentDirection() const {
-            return currentDirection;
+            return store.currentDirections[index];
         }
 
         MoveDirection getLastDirection() const {
-            return lastDirection;
+            return store.lastDirections[index];
         }
 
         int getCurrentAnimationOffset() const {
-            return (animationTicks % 20) / 10 + textureOffset;
+            return (store.animationTicks[index] % 20) / 10 + store.textureOffsets[index];
         }
 
-        void setGroundLevel(double _groundLevel) {
-            groundLevel = _groundLevel;
-            position.setY(_groundLevel);
+        BoundingBox getHitbox() const {
+            return store.hitboxes[index];
         }
 
-        BoundingBox getHitbox() const;
-
-        virtual void move(double ms);
-
-        virtual void shoot() {}
-
-        // CORGI moves along a set predetermined track
-        void moveOnTrack(double ms);
-
-        // Moves the CORGI in either direction
-        void moveLeft();
-        void moveRight();
-
         int getTextureOffset() const {
-            return textureOffset;
+            return store.textureOffsets[index];
         }
 };
 
-#endif
\ No newline at end of file
+#endif
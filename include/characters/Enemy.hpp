@@ -1,13 +1,13 @@
 #ifndef _ENEMY_H
 #define _ENEMY_H
 
-#include "Character.hpp"
+#include "characters/EntityStore.hpp"
 #include "MoveDirection.hpp"
+#include "mathutils.hpp"
 #include "physics/Vector2.hpp"
 #include "physics/BoundingBox.hpp"
 #include <memory>
-#include "EnemyProjectile.hpp"
-#include <deque>
+#include <vector>
 #include "SDL.h"
 //#include "characters/Player.hpp"
 
@@ -24,128 +24,85 @@ const int MAX_ENEMY_PROJECTILES = 2;
 // Delay for shooting projectiles in ms
 const int ENEMY_PROJECTILE_DELAY = 1000;
 
-class GameLogic;
-
-class Enemy : public Character {
-
-    private:
-        GameLogic& gameLogic;
-
-        // There is a delay between shooting projectiles
-        SDL_TimerID enemyProjectileTimerId;
-        bool isEnemyProjectileTimerActive = false; //= false;
-
-        // Set initial direction
-        MoveDirection currentDirection = MoveDirection::RIGHT;
-
-        // Last direction moved
-        MoveDirection lastDirection = MoveDirection::RIGHT;
+// Enemy hitbox dimensions
+const BoundingBox ENEMY_HITBOX = BoundingBox(Vector2(-5, -24), Vector2(20, 56));
 
-        int animationTicks = 0;
+// Distance at which an enemy that can shoot notices the player
+const double ENEMY_DETECT_RANGE = 200;
 
-        // Enemy hitbox dimensions
-        BoundingBox hitbox = BoundingBox(Vector2(-5, -24), Vector2(20, 56));
-
-        // Track the enemy moves on
-        double trackStart, trackEnd;
-
-        // y-level of the ground
-        double groundLevel = 576;
-
-        // Amount of health
-        int health = 2;
-
-        Vector2 playerLoc; 
+class GameLogic;
 
-        double detectRange = 200;
+// View of a single enemy in the level's enemy EntityStore.
+// The index is only valid until an enemy is removed, so views should not be kept across ticks (keep a handle instead).
+class Enemy {
 
-        std::shared_ptr<EnemyProjectile> enemyProjectile;
-        
-         // List of available projectiles
-        std::deque<EnemyProjectile> enemyProjectiles;
+    private:
+        EntityStore& store;
+        size_t index;
 
-        // Texture offset for the enemy (can be either 0 or 2 for now)
-        int textureOffset = 0;
+    public:
+        Enemy(EntityStore& _store, size_t _index) : store(_store), index(_index) {}
 
-        bool canShoot = false; // Shoots and follows the player
-        bool isBiker = false;
+        EntityHandle getHandle() const {
+            return store.handleAt(index);
+        }
 
-        bool moving = true; // checks if the enemy is moving, if so update animation ticks
+        const Vector2& getPosition() const {
+            return store.positions[index];
+        }
 
-    public:
-        explicit Enemy(GameLogic& _gameLogic, Vector2 _position, double _trackStart, double _trackEnd, bool _canShoot, bool _isBiker) : Character(_position), gameLogic(_gameLogic), trackStart(_trackStart), trackEnd(_trackEnd), canShoot(_canShoot), isBiker(_isBiker) {
-            velocity.setX(120);
-            textureOffset = rand() % 2 == 0 ? 0 : 2;
+        Vector2 getInterpolatedPosition(double interpolation) const {
+            return mathutils::lerp(store.previousPositions[index], store.positions[index], interpolation);
         }
 
         MoveDirection getCurrentDirection() const {
-            return currentDirection;
+            return store.currentDirections[index];
         }
 
         MoveDirection getLastDirection() const {
-            return lastDirection;
+            return store.lastDirections[index];
         }
 
         int getCurrentAnimationOffset() const {
-            return (animationTicks % 20) / 10 + textureOffset;
+            return (store.animationTicks[index] % 20) / 10 + store.textureOffsets[index];
         }
 
         int getBikerAnimationOffset() const {
-            return (animationTicks % 30) / 10;
-        }
-        void setGroundLevel(double _groundLevel) {
-            groundLevel = _groundLevel;
-            position.setY(_groundLevel);
+            return (store.animationTicks[index] % 30) / 10;
         }
 
         BoundingBox getHitbox() const;
 
-        virtual void move(double ms);
-
-        void moveToPlayer(std::shared_ptr<Player> player);
-
-        bool detectPlayer(std::shared_ptr<Player> player, double ms);
+        void moveToPlayer();
 
-        virtual void shoot();
+        // Checks if the player is in range and not behind a wall, following and shooting at them if they are.
+        // Enemies that don't see the player go back to patrolling their track.
+        bool detectPlayer(GameLogic& gameLogic, const Player& player);
 
-        // Enemy moves along a set predetermined track
-        void moveOnTrack(double ms);
+        void shoot(GameLogic& gameLogic);
 
         // Moves the enemy in either direction
         void moveLeft();
         void moveRight();
 
         void decrementHealth() {
-            health--;
+            store.healths[index]--;
         }
 
         bool isAlive() const {
-            return health > 0;
-        }
-
-        //std::shared_ptr<EnemyProjectile> getEnemyProjectile();
-
-        std::deque<EnemyProjectile>& getProjectiles() {
-            return enemyProjectiles;
-        }
-
-        // Sets if the projectile timer is active
-        void setIfProjectileTimerActive(bool active) {
-            isEnemyProjectileTimerActive = active;
+            return store.healths[index] > 0;
         }
 
         int getTextureOffset() const {
-            return textureOffset;
+            return store.textureOffsets[index];
         }
 
-        void updateProjectiles(double ms);
-
         bool getCanShoot() const {
-            return canShoot;
+            return store.hasFlag(index, ENTITY_CAN_SHOOT);
         }
 
         bool isEnemyBiker() const {
-            return isBiker;
+            return store.hasFlag(index, ENTITY_BIKER);
         }
 };
 
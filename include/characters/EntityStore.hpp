@@ -0,0 +1,137 @@
+#ifndef _ENTITY_STORE_H
+#define _ENTITY_STORE_H
+
+#include "MoveDirection.hpp"
+#include "TimerWheel.hpp"
+#include "HandleTable.hpp"
+#include "physics/Vector2.hpp"
+#include "physics/BoundingBox.hpp"
+
+#include <cstdint>
+#include <vector>
+
+// Speed (pixels per second) that entities walk along their tracks
+const double TRACK_SPEED = 120;
+
+// Health that every entity starts with (only enemies can be hurt)
+const int ENTITY_HEALTH = 2;
+
+// y-level of the ground for entities that weren't placed above a collider
+const double DEFAULT_GROUND_LEVEL = 576;
+
+// Per-entity state flags
+enum EntityFlag : uint8_t {
+    ENTITY_PATROLLING = 1, // Walks back and forth along its track during moveOnTracks
+    ENTITY_MOVING = 2, // The walking animation advances
+    ENTITY_CAN_SHOOT = 4, // Shoots at and follows the player
+    ENTITY_BIKER = 8,
+    ENTITY_ACTIVE = 16, // Cleared once a powerup is collected
+    ENTITY_COOLDOWN = 32, // Waiting before it can shoot again
+    ENTITY_ASLEEP = 64 // Too far from the camera, skipped by every per-tick update until it wakes up
+};
+
+// Refers to an entity in an EntityStore
+using EntityHandle = Handle;
+
+// Structure-of-arrays storage for the level's enemies, corgis and powerups.
+// Every component lives in its own contiguous array indexed by the entity's dense index, so whole-store passes
+// like moveOnTracks only touch the data they need. Enemy, Corgi and Powerup are lightweight views into a store.
+class EntityStore {
+    private:
+    friend class Enemy;
+    friend class Corgi;
+    friend class Powerup;
+
+    // Components, indexed by dense index
+    std::vector<Vector2> positions;
+    std::vector<Vector2> previousPositions; // Position at the start of the tick, for drawing between ticks
+    std::vector<Vector2> velocities;
+    std::vector<double> trackStarts;
+    std::vector<double> trackEnds;
+    std::vector<double> groundLevels;
+    std::vector<BoundingBox> hitboxes;
+    std::vector<int> healths;
+    std::vector<int> animationTicks;
+    std::vector<int> textureOffsets;
+    std::vector<MoveDirection> currentDirections;
+    std::vector<MoveDirection> lastDirections;
+    std::vector<uint8_t> flags;
+    std::vector<double> sleepStarts; // Store time when the entity fell asleep
+
+    // Only used by enemies
+    std::vector<Vector2> targets; // Last seen player position
+    std::vector<TimerHandle> cooldownTimers;
+
+    HandleTable handles;
+
+    // Total ms the store has been updated for, used to work out how long sleeping entities slept
+    double time = 0;
+
+    // Shrinks every component array to the first count entities
+    void truncate(size_t count);
+
+    // Moves a sleeping entity along its track as if it had been walking for this many ms
+    void advanceOnTrack(size_t index, double ms);
+
+    public:
+    // Adds an entity and returns its handle, it will have the dense index size() - 1
+    EntityHandle add(const Vector2& position, double trackStart, double trackEnd, const BoundingBox& hitbox, uint8_t entityFlags, int textureOffset = 0);
+
+    // Removes every entity that died (ran out of health) or was deactivated (collected) during the tick.
+    // This runs once at the end of a tick, so dense indexes stay the same for the whole tick.
+    void compact();
+
+    // Removes every entity
+    void clear();
+
+    size_t size() const {
+        return positions.size();
+    }
+
+    bool isValid(EntityHandle handle) const {
+        return handles.isValid(handle);
+    }
+
+    // Dense index of a valid handle
+    size_t indexOf(EntityHandle handle) const {
+        return handles.indexOf(handle);
+    }
+
+    EntityHandle handleAt(size_t index) const {
+        return handles.handleAt(index);
+    }
+
+    bool hasFlag(size_t index, EntityFlag flag) const {
+        return (flags[index] & flag) != 0;
+    }
+
+    void setFlag(size_t index, EntityFlag flag, bool value) {
+        if (value) {
+            flags[index] |= flag;
+        } else {
+            flags[index] &= ~flag;
+        }
+    }
+
+    const Vector2& getPosition(size_t index) const {
+        return positions[index];
+    }
+
+    // Puts an entity on the ground at the given y-level
+    void setGroundLevel(size_t index, double groundLevel);
+
+    // Puts entities that can't reach [windowStart, windowEnd] to sleep and wakes the ones that can (a patrolling entity can reach its whole track).
+    // Patrolling entities that wake up are moved to where they would have walked along their track in the meantime.
+    void updateActivity(double windowStart, double windowEnd, double ms);
+
+    // Remembers every position before a new tick runs
+    void savePreviousPositions();
+
+    // Moves every awake patrolling entity along its track, turning around at the ends
+    void moveOnTracks(double ms);
+
+    // Advances every awake entity's animation by a tick
+    void animate();
+};
+
+#endif
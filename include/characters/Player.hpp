@@ -9,8 +9,7 @@
 #include "physics/BoundingBox.hpp"
 #include "physics/Vector2.hpp"
 #include "SoundManager.hpp"
-
-#include <deque>
+#include "TimerWheel.hpp"
 
 const int PLAYER_WIDTH = 32;
 const int PLAYER_HEIGHT = 64;
@@ -42,11 +41,8 @@ class Player : public Character {
     // Direction the player was moving when they jumped/fell
     MoveDirection fallDirection = MoveDirection::NONE;
 
-    // List of available projectiles
-    std::deque<Projectile> projectiles;
-
     // There is a delay between shooting projectiles
-    SDL_TimerID projectileTimerId;
+    TimerHandle projectileTimer;
     bool isProjectileTimerActive = false;
 
     // Which animation frame to use (track how many ticks the current movement has occurred for)
@@ -60,18 +56,17 @@ class Player : public Character {
 
     bool onGround=false;
     bool falling=true;
-    double fallHeight;
 
     bool isJumping=false;
 
     bool invincibilityFramesActive = false;
-    SDL_TimerID invincibilityTimerId;
+    TimerHandle invincibilityTimer;
 
     //handles speed reduction from enemies and obstacles
     bool isSlowed = false;
     bool isFast = false;
-    SDL_TimerID slowTimerId;
-    SDL_TimerID fastTimerId; 
+    TimerHandle slowTimer;
+    TimerHandle fastTimer;
     const float NORMAL_SPEED = 200.0f;
     const float REDUCED_SPEED = 100.0f;
     const float INCREASED_SPEED = 300.0f;
@@ -81,17 +76,23 @@ class Player : public Character {
 
     // Should speed be restored when the player lands
     bool restoreSpeedWhenLand = false;
+
+    // Reused list of nearby entities from the level's spatial hash
+    std::vector<const SpatialEntry*> nearbyEntities;
  
     // Handles falling off the map
     void checkForFallRespawn();
     void respawn();
 
-    // Handles any floor collisions
-    void handleFloorCollisions();
-    void handleCeilingCollisions();
+    // Makes the player invincible for INVINCIBILITY_FRAMES ms
+    void startInvincibility();
 
-    void handleRightCollisions();
-    void handleLeftCollisions();
+    // Moves the player along one axis, stopping at the first collider in the way
+    void moveHorizontally(double dx);
+    void moveVertically(double dy);
+
+    // Checks whether a grounded player is still on the ground
+    void handleFloorCollisions();
 
     // Detects collisions with the enemy
     void handleEnemyCollisions();
@@ -101,7 +102,7 @@ class Player : public Character {
     float getCurrentSpeed() const;
 
     public:
-    Player(GameLogic& _gameLogic, Vector2 _position) : Character(_position), gameLogic(_gameLogic), fallHeight(_position.getY() + PLAYER_HEIGHT / 2.0) {respawnPos = _position;}
+    Player(GameLogic& _gameLogic, Vector2 _position) : Character(_position), gameLogic(_gameLogic) {respawnPos = _position;}
 
     MoveDirection getCurrentDirection() const {
         return currentDirection;
@@ -111,10 +112,6 @@ class Player : public Character {
         return lastDirection;
     }
 
-    const std::deque<Projectile>& getProjectiles() const {
-        return projectiles;
-    }
-
     int getCurrentAnimationOffset() const;
 
     BoundingBox getHitbox() const;
@@ -1,79 +1,62 @@
 #ifndef _Powerup_HPP
 #define _Powerup_HPP
-#include "Character.hpp"
+#include "characters/EntityStore.hpp"
 #include "MoveDirection.hpp"
+#include "mathutils.hpp"
 #include "physics/Vector2.hpp"
 #include "physics/BoundingBox.hpp"
 
 const int POWERUP_WIDTH = 32;
 const int POWERUP_HEIGHT = 64;
 
-class Powerup : public Character {
+// Powerup hitbox dimensions
+const BoundingBox POWERUP_HITBOX = BoundingBox(Vector2(-10, -10), Vector2(20, 25));
 
-    private:
-        // Set initial direction
-        MoveDirection currentDirection = MoveDirection::RIGHT;
-
-        // Last direction moved
-        MoveDirection lastDirection = MoveDirection::RIGHT;
-
-        int animationTicks = 0;
-
-        // Powerup hitbox dimensions
-        BoundingBox hitbox = BoundingBox(Vector2(-10, -10), Vector2(20, 25));
-
-        // both set to the same value
-        double trackStart, trackEnd;
+// View of a single powerup in the level's powerup EntityStore
+class Powerup {
 
-        // y-level of the ground
-        double groundLevel = 576;
+    private:
+        EntityStore& store;
+        size_t index;
 
-        // Texture offset for the Powerup (can be either 0 or 2 for now)
-        int textureOffset = 0;
+    public:
+        Powerup(EntityStore& _store, size_t _index) : store(_store), index(_index) {}
 
-        // indicates if the powerup is still on the screen
-        bool active = true;
+        const Vector2& getPosition() const {
+            return store.positions[index];
+        }
 
-    public:
-        Powerup(Vector2 _position, double _trackStart, double _trackEnd) : Character(_position), trackStart(_trackStart), trackEnd(_trackEnd) {}
+        Vector2 getInterpolatedPosition(double interpolation) const {
+            return mathutils::lerp(store.previousPositions[index], store.positions[index], interpolation);
+        }
 
         MoveDirection getCurrentDirection() const {
-            return currentDirection;
+            return store.currentDirections[index];
         }
 
         MoveDirection getLastDirection() const {
-            return lastDirection;
+            return store.lastDirections[index];
         }
-        int getCurrentAnimationOffset() const;
 
+        int getCurrentAnimationOffset() const;
 
-        void setGroundLevel(double _groundLevel) {
-            groundLevel = _groundLevel;
-            position.setY(_groundLevel);
+        BoundingBox getHitbox() const {
+            return store.hitboxes[index];
         }
 
-        BoundingBox getHitbox() const;
-
-        virtual void move(double ms);
-
-        virtual void shoot() {}
-
-        void animate();
-
-
         int getTextureOffset() const {
-            return textureOffset;
+            return store.textureOffsets[index];
         }
 
         // returns activation status
-        bool isActive() {
-            return active;
+        bool isActive() const {
+            return store.hasFlag(index, ENTITY_ACTIVE);
         }
 
         // deactivates a powerup for cleanup
         void deactivate() {
-            active = false;
+            store.setFlag(index, ENTITY_ACTIVE, false);
         }
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -17,9 +17,24 @@ class Layer {
     std::string name;
     float opacity;
 
+    // Indexes into blocks ordered column by column, the blocks in column c are columnBlocks[columnStarts[c]] up to columnBlocks[columnStarts[c + 1]]
+    // Only blocks that need to be drawn are in here
+    std::vector<int> columnBlocks;
+    std::vector<int> columnStarts;
+
+    // Set if the whole layer is one solid colour, which is drawn with a single fill instead of its blocks
+    bool filled = false;
+    SDL_Color fillColor = { 0, 0, 0, 0 };
+
+    // Fills columnBlocks and columnStarts from the blocks that aren't hidden (every block if hidden is empty)
+    void buildColumnIndex(const std::vector<bool>& hidden);
 
     public:
-    Layer(std::vector<std::tuple<Vector2, int>> _blocks, std::vector<uint32_t> _ids, std::string _name, float _opacity) : blocks(_blocks), ids(_ids), name(_name), opacity(_opacity){}
+    Layer(std::vector<std::tuple<Vector2, int>> _blocks, std::vector<uint32_t> _ids, std::string _name, float _opacity) : blocks(_blocks), ids(_ids), name(_name), opacity(_opacity) {
+        buildColumnIndex({});
+    }
+
+    using BlockRange = std::pair<std::vector<int>::const_iterator, std::vector<int>::const_iterator>;
 
     const std::vector<std::tuple<Vector2, int>>& getBlocks() const {
         return blocks;
@@ -32,6 +47,30 @@ class Layer {
     uint32_t getID(int index) const;
 
     bool hasFlipFlag(int index) const ;
+
+    // Indexes of the blocks in columns firstColumn to lastColumn (inclusive) that need to be drawn, column by column
+    BlockRange getBlocksInColumns(int firstColumn, int lastColumn) const;
+
+    // Leaves the given blocks (ie: ones covered by an opaque tile on a higher layer) out of drawing
+    void hideBlocks(const std::vector<bool>& hidden) {
+        buildColumnIndex(hidden);
+    }
+
+    // Draws the layer as a single fill of the given colour, instead of drawing its blocks
+    void setFill(SDL_Color color) {
+        filled = true;
+        fillColor = color;
+        buildColumnIndex(std::vector<bool>(blocks.size(), true));
+    }
+
+    bool hasFill() const {
+        return filled;
+    }
+
+    SDL_Color getFillColor() const {
+        return fillColor;
+    }
+
     float getOpacity() const{
         return opacity;
     }
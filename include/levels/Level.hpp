@@ -12,7 +12,11 @@
 #include <tmxlite/Tileset.hpp>
 #include <tmxlite/Property.hpp>
 #include "sprites/Spritesheet.hpp"
+#include "sprites/TextureAtlas.hpp"
 #include "physics/BoundingBox.hpp"
+#include "physics/SpatialHash.hpp"
+#include "levels/WorldQuery.hpp"
+#include "levels/TileChunks.hpp"
 #include "SDL.h"
 #include "SDL_image.h"
 #include "Layer.hpp"
@@ -21,20 +25,63 @@
 #include "levels/LevelData.hpp"
 #include "characters/Corgi.hpp"
 #include "characters/Powerup.hpp"
+#include "ProjectilePool.hpp"
 
 
+// Behaviour flags of a collision object, interned from its type when the level loads
+enum ColliderFlag : uint8_t {
+    COLLIDER_OBSTACLE = 1 // Slows the player down when they stand on it
+};
+
 // Structure to represent a tsx object
 struct CollisionObject {
     SDL_Rect bounds;
     std::string type;
     std::string name;
+    uint8_t flags = 0;
+};
+
+// Flags of a tile GID
+enum TileFlag : uint8_t {
+    TILE_HITBOX = 1, // Only drawn when hitboxes are shown
+    TILE_COLLIDER = 2 // Has at least one collision object
+};
+
+// Everything drawing and collisions need to know about a tile GID
+struct TileInfo {
+    // Index into the level's spritesheets (-1 if no tileset contains the GID), and of the tile within that spritesheet
+    int spritesheet = -1;
+    int spriteIndex = 0;
+
+    // Collision objects of the tile (with local coordinates) are colliderTemplates[firstCollider] up to firstCollider + colliderCount
+    int firstCollider = 0;
+    int colliderCount = 0;
+
+    uint8_t flags = 0;
 };
 
+// Result of casting a ray through the level's tile grid
+struct RaycastHit {
+    bool hit = false;
+
+    // First point along the ray touching a collider, and how far it is from the start of the ray
+    Vector2 point;
+    double distance = 0;
+
+    // Tile containing the collider that was hit
+    int column = -1;
+    int row = -1;
+
+    // Normal of the collider's surface that was hit (zero if the ray started inside it)
+    Vector2 normal;
+
+    const CollisionObject* object = nullptr;
+};
 
 
 
 // Class for the current level's data
-class Level {
+class Level : public WorldQuery {
     private:
     Vector2 dimensions;
     // For now the level is just going to have a few blocks to be drawn (this is temporary)
@@ -42,22 +89,80 @@ class Level {
     std::vector<std::tuple<Vector2,int>> blocks; // int will be 1 if there is a flip flag for the tile
 
     std::vector<std::shared_ptr<Spritesheet>> spritesheets;
+
+    // Every tileset packed into one or a few textures
+    TextureAtlas tileAtlas;
     std::vector<uint32_t> ids;
     std::vector<std::shared_ptr<Layer>> layers;
 
-    // List of GIDs of hitboxes
-    std::set<uint32_t> hitboxIDs;
-
     // Store all collision objects in the world with globally based coordinates
     std::vector<CollisionObject> collisionObjects;
 
-    // Store tile IDs with their respective collision object with local coordinates (ie: since the bounds for a grass block are the full sqaure, x:0, y:0, w:32, h:32)
-    std::unordered_map<uint32_t, std::vector<CollisionObject>> tileCollisions;
+    // Dense table indexed by GID, filled in when the tilesets are loaded (entry 0 is the empty tile)
+    std::vector<TileInfo> tileInfo;
+
+    // Collision objects of every tile with local coordinates (ie: since the bounds for a grass block are the full sqaure, x:0, y:0, w:32, h:32)
+    std::vector<CollisionObject> colliderTemplates;
+
+    // Dense grid of the world collision object at each tile, indexed by row * gridColumns + column (nullptr if the tile has no collider)
+    // This points into collisionObjects, so it must be rebuilt if that list ever changes
+    std::vector<const CollisionObject*> collisionGrid;
+    int gridColumns = 0;
+    int gridRows = 0;
+
+    // Bit-packed solid mask (one bit per tile with a collider), stored row by row so that a horizontal span can be scanned a 64 bit word at a time
+    std::vector<uint64_t> solidRows;
+    int wordsPerRow = 0;
+
+    // Fills collisionGrid and the row-by-row solid mask once all of the collision objects have been loaded
+    void buildCollisionGrid(int columns, int rows);
+
+    // Runs and blocks of identical full-tile colliders merged into the largest rectangles that fit (other colliders are kept as they are)
+    std::vector<CollisionObject> mergedColliders;
+
+    // Index into mergedColliders of the rectangle covering each tile, laid out like collisionGrid (-1 if the tile has no collider)
+    std::vector<int> mergedGrid;
+
+    // Reused list of merged colliders already tested during a sweep
+    mutable std::vector<int> sweptColliders;
+
+    // Greedily merges the colliders in collisionGrid into mergedColliders and fills mergedGrid
+    void buildMergedColliders();
+
+    // Walkable top surfaces (world y of a collider with no collider in the tile above it) of every tile column, sorted top to bottom.
+    // The surfaces of column c are surfaceTops[surfaceStarts[c]] up to surfaceTops[surfaceStarts[c + 1]]
+    std::vector<int> surfaceStarts;
+    std::vector<int> surfaceTops;
+
+    // Fills the surface lists from collisionGrid
+    void buildSurfaceMap();
+
+    // Puts the most recently added entity of a store on the ground under its spawn point (if there is any)
+    void snapToGround(EntityStore& store, const BoundingBox& hitbox, double height);
+
+    // Coverage of the frame drawn for a tile GID (nullptr if it isn't known)
+    const FrameCoverage* getTileCoverage(uint32_t gid) const;
+
+    // Leaves tiles that can't be seen (fully transparent, or under an opaque tile of a higher layer) out of drawing,
+    // and turns layers made of a single solid colour into fills
+    void cullOverdraw();
+
+    // Tile layers pre-rendered into textures for drawing
+    TileChunks tileChunks;
+
+    // Enemy entities (along with corgis and powerups), accessed through the Enemy, Corgi and Powerup views
+    EntityStore enemies;
+    EntityStore corgis;
+    EntityStore powerups;
+
+    // Every player and enemy projectile in the level
+    ProjectilePool projectiles;
+
+    // Broad phase for collisions between entities, rebuilt at the start of every tick
+    SpatialHash spatialHash;
 
-    // List of enemy entities
-    std::vector<std::shared_ptr<Enemy>> enemies;
-    std::vector<std::shared_ptr<Corgi>> corgis;
-    std::vector<std::shared_ptr<Powerup>> powerups;
+    // Reused list of spatial hash query results
+    std::vector<const SpatialEntry*> nearbyEntries;
 
     //List of EnemyData
     std::vector<EnemyData> levelEnemyData;
@@ -73,7 +178,7 @@ class Level {
     Vector2 playerspawn;
     std::vector<Vector2> enemyspawns;
     public:
-    explicit Level() {}
+    explicit Level() : tileInfo(1) {}
     void setDimensions(const Vector2& dims)  {
         dimensions = dims;
     }
@@ -92,29 +197,79 @@ class Level {
         return blocks;
     }
 
-    std::unordered_map<unsigned int, std::vector<CollisionObject>>& getTileCollisions() {
-        return tileCollisions;
+    // Information about a tile GID (GIDs outside every tileset get an empty entry)
+    const TileInfo& getTileInfo(uint32_t gid) const {
+        return gid < tileInfo.size() ? tileInfo[gid] : tileInfo[0];
     }
 
     std::vector<std::shared_ptr<Layer>>& getLayers() {
         return layers;
     }
 
-    std::vector<std::shared_ptr<Enemy>>& getEnemies() {
+    std::vector<std::shared_ptr<Spritesheet>>& getSpritesheets() {
+        return spritesheets;
+    }
+
+    const TileChunks& getTileChunks() const {
+        return tileChunks;
+    }
+
+    TileChunks& getTileChunks() {
+        return tileChunks;
+    }
+
+    EntityStore& getEnemies() {
         return enemies;
     }
 
-    std::vector<std::shared_ptr<Corgi>>& getCorgis() {
+    EntityStore& getCorgis() {
         return corgis;
     }
 
-    std::vector<std::shared_ptr<Powerup>>& getPowerups() {
+    EntityStore& getPowerups() {
         return powerups;
     }
+
+    ProjectilePool& getProjectiles() {
+        return projectiles;
+    }
+
+    // Views of the entity at a dense index
+    Enemy getEnemy(size_t index) {
+        return Enemy(enemies, index);
+    }
+
+    Corgi getCorgi(size_t index) {
+        return Corgi(corgis, index);
+    }
+
+    Powerup getPowerup(size_t index) {
+        return Powerup(powerups, index);
+    }
+
     double getLevelEndPos() const {
         return levelEndPos;
     }
 
+    // Every world collider after merging neighbouring tiles
+    const std::vector<CollisionObject>& getMergedColliders() const {
+        return mergedColliders;
+    }
+
+    // returns the merged collider covering the given tile (nullptr if the tile has no collider)
+    const CollisionObject* getMergedCollisionObject(int column, int row) const;
+
+    SpatialHash& getSpatialHash() {
+        return spatialHash;
+    }
+
+    // Puts the enemies, corgis and powerups outside the window (x range in world coordinates) to sleep, and wakes the ones inside it
+    void updateActivity(double windowStart, double windowEnd, double ms);
+
+    // Rebuilds the spatial hash from the current (awake) enemies, corgis, powerups and projectiles.
+    // Entries refer to list indexes, so it needs to be rebuilt after anything is added or removed.
+    void updateSpatialHash();
+
     // gets global ID for a given block
     uint32_t getID(const Vector2& block) const;
 
@@ -129,34 +284,58 @@ class Level {
         blocks = _blocks;
     }
 
-    // Does the list of hitbox IDs contain the given gid?
+    // Is the given gid a hitbox tile?
     bool isHitboxGID(uint32_t gid) const {
-        return hitboxIDs.find(gid) != hitboxIDs.end();
+        return (getTileInfo(gid).flags & TILE_HITBOX) != 0;
     }
 
     // Does the tile ID has collisions associated with it?
     bool isCollisionGID(uint32_t gid) const {
-        return tileCollisions.find(gid) !=tileCollisions.end();
+        return (getTileInfo(gid).flags & TILE_COLLIDER) != 0;
     }
 
     // bool collidedWith(const Vector2& position) const;
     // Returns if there is a tile at the given position with a collider
     bool colliderTileAt(const Vector2& position) const;
 
-    // gets the correct spritesheet given a specific global ID
-    std::shared_ptr<Spritesheet> getSpritesheetForGID(uint32_t gid);
+    // Returns the first column in [colStart, colEnd] of the given row that has a collider, or -1 if there is none
+    int firstSolidColumn(int row, int colStart, int colEnd) const;
+
+    // Moves a box (in world coordinates) along the displacement and returns the first collider it runs into.
+    // A box that already overlaps a collider only hits it if it is moving further into it.
+    virtual SweepResult sweepBox(const BoundingBox& box, const Vector2& displacement) const;
+
+    // Walks the tile grid from origin along direction (DDA), stopping at the first collider within maxDistance
+    RaycastHit raycast(const Vector2& origin, const Vector2& direction, double maxDistance) const;
+
+    // Casts a ray from one point to another, stopping at the first collider in between
+    RaycastHit castSegment(const Vector2& from, const Vector2& to) const;
+
+    // Checks that no collider blocks the straight line between two points
+    bool hasLineOfSight(const Vector2& from, const Vector2& to) const {
+        return !castSegment(from, to).hit;
+    }
+
+    // Hurts the first enemy whose hitbox overlaps the box, using the spatial hash built at the start of the tick
+    virtual bool damageEnemyAt(const BoundingBox& box);
+
+    // gets the correct spritesheet given a specific global ID (nullptr if there is none)
+    Spritesheet* getSpritesheetForGID(uint32_t gid) const;
 
     // loads map from tmx file, and populates spritesheets, blocks, and ids
     // later should be adjusted to account for layering and flip flags
     bool loadFromTMX(const std::string& filename, SDL_Renderer* renderer);
 
-    // Loads the level using the level data
-    bool loadData(GameLogic& gameLogic, LevelData& levelData, SDL_Renderer* renderer);
+    // Returns the world y of the first walkable surface at or below y in the tile column containing x (-1 if there is none)
+    double groundBelow(double x, double y) const;
 
-    // Removes all enemies that died during the last tick
-    void removeDeadEnemies();
+    // Loads the level using the level data
+    bool loadData(LevelData& levelData, SDL_Renderer* renderer);
 
-    void removeCollectedPowerups();
+    // Removes the enemies that died, the powerups that were collected and the projectiles that stopped during the tick.
+    // Everything is removed in one pass at the end of the tick, so indexes stay the same while the tick runs
+    // (anything kept across ticks should hold a handle instead).
+    void removeFinishedEntities();
 
     ~Level() {}
 };
@@ -0,0 +1,71 @@
+#ifndef _TILE_CHUNKS_H
+#define _TILE_CHUNKS_H
+
+#include "SDL.h"
+#include <vector>
+
+class Level;
+
+// Width in pixels of each pre-rendered chunk of the level (16 tiles)
+const int CHUNK_WIDTH = 512;
+
+// A run of consecutive tile layers with the same opacity, rendered into one row of chunks
+struct ChunkGroup {
+    float opacity = 1.0;
+
+    // Layers firstLayer to lastLayer (inclusive) of the level
+    size_t firstLayer = 0;
+    size_t lastLayer = 0;
+
+    // Chunk i covers the x range [i * CHUNK_WIDTH, (i + 1) * CHUNK_WIDTH) of the level (nullptr until it is rendered, or after it was freed)
+    std::vector<SDL_Texture*> chunks;
+};
+
+// The level's static tile layers, rendered into fixed-width render target textures.
+// Drawing the level then only copies the few chunks that overlap the screen instead of every tile of every layer.
+// Chunks are rendered the first time they come on screen, and are registered with TextureResidency,
+// so ones that haven't been seen in a while can be freed (and rendered again when they come back on screen).
+class TileChunks {
+    private:
+    SDL_Renderer* renderer = nullptr;
+
+    // Level the chunks are rendered from
+    Level* level = nullptr;
+
+    std::vector<ChunkGroup> groups;
+
+    int height = 0;
+
+    bool baked = false;
+
+    // Draws the tiles of one layer that fall inside the given chunk into the current render target
+    void drawLayerChunk(size_t layerIndex, int chunk, SDL_BlendMode blendMode);
+
+    // Renders a chunk of a group into a new texture, returning false if the texture couldn't be created
+    bool renderChunk(size_t groupIndex, int chunk);
+
+    // Frees every chunk texture
+    void destroy();
+
+    public:
+    TileChunks() {}
+
+    // Chunks own their textures
+    TileChunks(const TileChunks&) = delete;
+    TileChunks& operator=(const TileChunks&) = delete;
+
+    // Sets up chunks for the level's tile layers (hitbox tiles are left out so they can be toggled).
+    // The level has to outlive the chunks. Returns false, leaving nothing baked, if the renderer can't render to textures.
+    bool bake(SDL_Renderer* _renderer, Level& _level);
+
+    bool isBaked() const {
+        return baked;
+    }
+
+    // Copies the chunks that overlap the screen, with the layer opacity multiplied by alpha (rendering any that aren't yet)
+    void draw(double scrollOffset, double alpha);
+
+    ~TileChunks();
+};
+
+#endif
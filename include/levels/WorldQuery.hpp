@@ -0,0 +1,36 @@
+#ifndef _WORLD_QUERY_H
+#define _WORLD_QUERY_H
+
+#include "physics/Vector2.hpp"
+#include "physics/BoundingBox.hpp"
+
+struct CollisionObject;
+
+// Result of sweeping a box through the level's colliders
+struct SweepResult {
+    bool hit = false;
+
+    // Fraction of the movement (0 to 1) that can happen before touching the collider
+    double time = 1;
+
+    // Normal of the collider's surface that was hit (ie: (0, -1) when landing on top of a tile)
+    Vector2 normal;
+
+    const CollisionObject* object = nullptr;
+};
+
+// Abstract class
+// The lookups that moving objects (like projectiles) need to make against the world, without owning or copying any game state.
+// Level is the real implementation, anything else (like a stub world) can stand in for it.
+class WorldQuery {
+    public:
+    // Moves a box (in world coordinates) along the displacement and returns the first collider it runs into
+    virtual SweepResult sweepBox(const BoundingBox& box, const Vector2& displacement) const = 0;
+
+    // Takes a point of health from the first enemy overlapping the box (in world coordinates), returns false if there isn't one
+    virtual bool damageEnemyAt(const BoundingBox& box) = 0;
+
+    virtual ~WorldQuery() {}
+};
+
+#endif
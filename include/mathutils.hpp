@@ -1,6 +1,8 @@
 #ifndef _MATH_UTILS_H
 #define _MATH_UTILS_H
 
+#include "physics/Vector2.hpp"
+
 namespace mathutils {
     bool isBetween(double num, double low, double high);
 
@@ -8,6 +10,9 @@ namespace mathutils {
 
     // Rounds a number down to the nearest interval
     double floorInterval(double num, double interval);
+
+    // Linearly interpolates between two points (t = 0 gives from, t = 1 gives to)
+    Vector2 lerp(const Vector2& from, const Vector2& to, double t);
 }
 
 #endif
\ No newline at end of file
@@ -0,0 +1,73 @@
+#ifndef _SPATIAL_HASH_H
+#define _SPATIAL_HASH_H
+
+#include "physics/BoundingBox.hpp"
+#include "physics/Vector2.hpp"
+
+#include <vector>
+#include <cstddef>
+
+// Width and height of a single spatial hash cell in pixels
+const double SPATIAL_CELL_SIZE = 128;
+
+// Kinds of entities stored in the spatial hash, these are bit flags so a query can ask for several at once
+enum SpatialKind : unsigned int {
+    SPATIAL_ENEMY = 1,
+    SPATIAL_CORGI = 2,
+    SPATIAL_POWERUP = 4,
+    SPATIAL_PLAYER_PROJECTILE = 8,
+    SPATIAL_ENEMY_PROJECTILE = 16
+};
+
+// A single entity in the spatial hash
+struct SpatialEntry {
+    BoundingBox bounds; // World coordinates
+    SpatialKind kind;
+    size_t index; // Index into the list the entity came from (enemies, corgis, powerups or the level's projectiles)
+};
+
+// Uniform grid over the level used as a broad phase for entity collisions.
+// Entities are inserted, then build() buckets them into cells, after which query() returns the entities near a box.
+class SpatialHash {
+    private:
+    int columns = 1;
+    int rows = 1;
+
+    std::vector<SpatialEntry> entries;
+
+    // Entry indexes grouped by cell, cell i owns cellEntries[cellStarts[i]] up to cellEntries[cellStarts[i + 1]]
+    std::vector<unsigned int> cellStarts;
+    std::vector<unsigned int> cellEntries;
+
+    // Scratch space for build(), kept so rebuilding every tick does not allocate
+    std::vector<unsigned int> writePositions;
+
+    // Used to make sure an entry spanning several cells is only returned once per query
+    std::vector<unsigned int> queryMarks;
+    unsigned int queryStamp = 0;
+
+    // Gets the (clamped) range of cells a box covers
+    void getCellRange(const BoundingBox& box, int& firstColumn, int& lastColumn, int& firstRow, int& lastRow) const;
+
+    public:
+    // Sets the area covered by the grid, anything outside is clamped to the edge cells
+    void resize(const Vector2& worldSize);
+
+    // Removes every entry
+    void clear();
+
+    void insert(const BoundingBox& bounds, SpatialKind kind, size_t index);
+
+    // Buckets the inserted entries into cells, this must be called before querying
+    void build();
+
+    // Finds the entries of the given kinds whose cells overlap the box, in insertion order.
+    // These are only candidates, the caller still needs to check the actual hitboxes.
+    void query(const BoundingBox& box, unsigned int kinds, std::vector<const SpatialEntry*>& results);
+
+    size_t size() const {
+        return entries.size();
+    }
+};
+
+#endif
@@ -3,4 +3,7 @@
 
 const float GRAVITY = 980.0f; 
 
+// Gap left between a moving box and the surface it stopped against, so the two are not touching on the next sweep
+const double COLLISION_SKIN = 0.01;
+
 #endif
\ No newline at end of file
@@ -0,0 +1,76 @@
+#ifndef _RENDER_QUEUE_H
+#define _RENDER_QUEUE_H
+
+#include "SDL.h"
+
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+// Order that the parts of the game screen are layered in (lower depths are drawn first)
+enum DrawDepth : unsigned int {
+    DEPTH_PLAYER = 1,
+    DEPTH_ENEMIES,
+    DEPTH_CORGIS,
+    DEPTH_POWERUPS,
+    DEPTH_PROJECTILES
+};
+
+// A textured rectangle waiting to be drawn
+struct DrawCommand {
+    // Sort key: depth above the texture id. Alpha goes in the vertex colours, so it doesn't need to split batches.
+    uint64_t key;
+
+    SDL_Texture* texture;
+    SDL_Rect source;
+    SDL_Rect destination;
+    Uint8 alpha;
+    bool flipped;
+};
+
+// RenderQueue collects the sprites drawn during a frame instead of drawing them right away.
+// When it is flushed, the sprites are sorted by depth and then texture (keeping the order they were submitted in otherwise),
+// and every run of sprites sharing a texture is drawn with a single SDL_RenderGeometry call.
+class RenderQueue {
+    private:
+    SDL_Renderer* renderer;
+
+    std::vector<DrawCommand> commands;
+
+    // Scratch space for the radix sort and the batched geometry, reused between frames
+    std::vector<DrawCommand> sorted;
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
+
+    // Small ids for the textures queued this frame (so they fit in the sort key), along with their sizes
+    struct TextureInfo {
+        uint32_t id;
+        int width;
+        int height;
+    };
+
+    std::unordered_map<SDL_Texture*, TextureInfo> textures;
+
+    const TextureInfo& getTextureInfo(SDL_Texture* texture);
+
+    // Sorts commands by key into sorted (least significant byte first, stable)
+    void radixSort();
+
+    // Draws the vertices and indices gathered for one texture
+    void submitBatch(SDL_Texture* texture);
+
+    public:
+    explicit RenderQueue(SDL_Renderer* _renderer) : renderer(_renderer) {}
+
+    // Queues part of a texture to be drawn at the destination
+    void push(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination, unsigned int depth, Uint8 alpha = 255, bool flipped = false);
+
+    // Draws everything queued since the last flush
+    void flush();
+
+    size_t size() const {
+        return commands.size();
+    }
+};
+
+#endif
@@ -4,6 +4,7 @@
 #include "SDL.h"
 #include "SDL_ttf.h"
 #include "physics/Vector2.hpp"
+#include "sprites/RenderQueue.hpp"
 
 class Sprite {
 
@@ -11,7 +12,7 @@ class Sprite {
         SDL_Texture* sprite;
         SDL_Rect textureRect;
         SDL_Rect targetRect;
-        unsigned int depth;
+        unsigned int depth = 0;
         
 
     public:
@@ -38,6 +39,9 @@ class Sprite {
 
         void draw(SDL_Renderer* renderer) const;
 
+        // Queues the sprite to be drawn at its depth
+        void draw(RenderQueue& queue) const;
+
 
 };
 
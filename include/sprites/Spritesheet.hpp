@@ -5,6 +5,18 @@
 #include "SDL_image.h"
 
 #include "physics/Vector2.hpp"
+#include "sprites/RenderQueue.hpp"
+
+#include <memory>
+#include <vector>
+
+// Which pixels of a frame are covered, worked out from its image data when it is packed into an atlas
+struct FrameCoverage {
+    bool opaque = false; // Every pixel is fully opaque
+    bool empty = false; // Every pixel is fully transparent
+    bool solid = false; // Every pixel is the same colour
+    SDL_Color color = { 0, 0, 0, 0 }; // The colour of a solid frame
+};
 
 // Spritesheet lets you load a single file to use it as a spritesheet
 class Spritesheet {
@@ -15,6 +27,9 @@ class Spritesheet {
 
     SDL_Texture* texture = nullptr;
 
+    // Handle to the texture from the resource cache, which owns it (unset while drawing from an atlas)
+    std::shared_ptr<SDL_Texture> cachedTexture;
+
     // Has the texture been loaded
     bool hasLoadedTexture = false;
 
@@ -27,8 +42,25 @@ class Spritesheet {
     int rows;
     int columns;
 
+    // Set when the frames were packed into a texture atlas, which owns the texture
+    bool usesAtlas = false;
+
+    // Source rect of every frame in the atlas page, and of its mirrored copy (empty if the atlas didn't store them)
+    std::vector<SDL_Rect> frames;
+    std::vector<SDL_Rect> flippedFrames;
+
+    // Coverage of every frame (empty if the sheet isn't in an atlas)
+    std::vector<FrameCoverage> coverage;
+
     void loadTexture();
 
+    // Finds where frame index is in the texture. flipped is cleared if the frame found is already mirrored.
+    // Returns false if there is no such frame.
+    bool getSource(int index, bool& flipped, SDL_Rect& source) const;
+
+    // Where a sprite centred at position is drawn
+    SDL_Rect getDestination(const Vector2& position) const;
+
     public:
     Spritesheet(SDL_Renderer* _renderer, std::string path, Vector2 _spriteSize, int _rows, int _columns);
 
@@ -43,12 +75,40 @@ class Spritesheet {
 
     bool containsID(uint32_t index) const;
 
+    const std::string& getPath() const {
+        return path;
+    }
+
+    const Vector2& getSpriteSize() const {
+        return spriteSize;
+    }
+
+    int getRows() const {
+        return rows;
+    }
+
+    int getColumns() const {
+        return columns;
+    }
+
+    // Draws from an atlas page instead of the sheet's own texture
+    void useAtlas(SDL_Texture* page, const std::vector<SDL_Rect>& _frames, const std::vector<SDL_Rect>& _flippedFrames, const std::vector<FrameCoverage>& _coverage);
+
+    // Which pixels of a frame are covered (nullptr if it isn't known)
+    const FrameCoverage* getCoverage(int index) const {
+        return index >= 0 && index < (int) coverage.size() ? &coverage[index] : nullptr;
+    }
+
+    // Sets how the texture is blended when drawn
+    void setBlendMode(SDL_BlendMode blendMode);
+
     // Draws the given texture at the given index
     void draw(int index, Vector2 position, bool flipped, float opacity);
 
     void draw(int index, Vector2 position);
 
-    ~Spritesheet();
+    // Queues the texture at the given index to be drawn when the queue is flushed
+    void draw(RenderQueue& queue, unsigned int depth, int index, Vector2 position, bool flipped, float opacity);
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,97 @@
+#ifndef _TEXTURE_ATLAS_H
+#define _TEXTURE_ATLAS_H
+
+#include "SDL.h"
+#include "SDL_image.h"
+
+#include "sprites/Spritesheet.hpp"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Width and height of an atlas page
+const int ATLAS_PAGE_SIZE = 2048;
+
+// TextureAtlas packs the images of several spritesheets into one or a few large textures when they are loaded,
+// so drawing sprites from different sheets doesn't switch textures. Sheets can also store a mirrored copy of
+// every frame, so flipped sprites are drawn with a plain copy instead of a flip transform.
+class TextureAtlas {
+    private:
+    // A spritesheet waiting to be packed
+    struct Entry {
+        Spritesheet* spritesheet;
+        bool storeFlipped;
+        std::shared_ptr<SDL_Surface> surface;
+
+        // Size of the frames in the sheet, and where they were placed
+        int width = 0;
+        int height = 0;
+        int page = 0;
+        int x = 0;
+        int y = 0;
+
+        // Where the mirrored frames were placed (if stored)
+        int flippedPage = 0;
+        int flippedX = 0;
+        int flippedY = 0;
+    };
+
+    std::vector<Entry> entries;
+
+    // Where the frames of every packed image ended up, so other sheets of the same image can draw from them too
+    struct Placement {
+        SDL_Texture* page;
+        std::vector<SDL_Rect> frames;
+        std::vector<SDL_Rect> flippedFrames;
+        std::vector<FrameCoverage> coverage;
+    };
+
+    std::map<std::string, Placement> placements;
+
+    std::vector<SDL_Texture*> pages;
+
+    static std::map<std::pair<SDL_Renderer*, std::string>, std::shared_ptr<TextureAtlas>> atlases;
+
+    // Places a width x height rectangle on the shelves of the pages, opening a new page if it doesn't fit
+    void place(int width, int height, int& page, int& x, int& y, std::vector<SDL_Rect>& shelves);
+
+    // Copies a sheet's frames into a page, mirroring each frame in place if flip is set
+    static void copyFrames(SDL_Surface* source, SDL_Surface* page, const Entry& entry, int x, int y, bool flip);
+
+    // Works out which pixels of a frame (in an RGBA32 surface) are covered
+    static FrameCoverage measureCoverage(SDL_Surface* source, const SDL_Rect& frame);
+
+    public:
+    TextureAtlas() {}
+
+    // The atlas owns its pages
+    TextureAtlas(const TextureAtlas&) = delete;
+    TextureAtlas& operator=(const TextureAtlas&) = delete;
+
+    // A named atlas shared by everything drawing to a renderer, empty until sheets are added to it and built
+    static std::shared_ptr<TextureAtlas> get(SDL_Renderer* renderer, const std::string& name);
+
+    // Drops every shared atlas (this must happen before the renderer is destroyed)
+    static void releaseAll();
+
+    // Adds a spritesheet to be packed by the next build (it has to stay alive until then)
+    void add(Spritesheet& spritesheet, bool storeFlipped);
+
+    // Packs every added spritesheet into pages, uploads them and points the spritesheets at their frames.
+    // Sheets that can't be loaded or don't fit on a page keep drawing from their own texture.
+    void build(SDL_Renderer* renderer);
+
+    // Points a spritesheet at the frames of its image if an earlier build packed it, returning false otherwise
+    bool apply(Spritesheet& spritesheet) const;
+
+    size_t getPageCount() const {
+        return pages.size();
+    }
+
+    ~TextureAtlas();
+};
+
+#endif
@@ -0,0 +1,72 @@
+#ifndef _GLYPH_ATLAS_H
+#define _GLYPH_ATLAS_H
+
+#include "SDL.h"
+#include "SDL_ttf.h"
+
+#include <map>
+#include <memory>
+#include <tuple>
+
+// Range of characters rasterized into the atlas (printable ASCII)
+const int FIRST_GLYPH = 32;
+const int LAST_GLYPH = 126;
+
+// Width in pixels of the atlas texture, glyphs wrap onto new rows past this
+const int GLYPH_ATLAS_WIDTH = 1024;
+
+// Where a character is in the atlas and how far it moves the pen
+struct Glyph {
+    SDL_Rect source = { 0, 0, 0, 0 };
+    int advance = 0;
+    bool present = false;
+};
+
+// GlyphAtlas rasterizes every character of a font once (in white, so text can be tinted any colour) into one texture.
+// Glyphs are rasterized at the size they are drawn at rather than scaled, so there is one atlas per font, pixel size and renderer, shared through get().
+class GlyphAtlas {
+    private:
+    SDL_Renderer* renderer;
+    TTF_Font* font;
+    int pixelSize;
+
+    SDL_Texture* texture = nullptr;
+
+    Glyph glyphs[LAST_GLYPH - FIRST_GLYPH + 1];
+
+    // Height of a line of text in atlas pixels
+    int lineHeight = 0;
+
+    static std::map<std::tuple<SDL_Renderer*, TTF_Font*, int>, std::shared_ptr<GlyphAtlas>> atlases;
+
+    void build();
+
+    public:
+    GlyphAtlas(SDL_Renderer* _renderer, TTF_Font* _font, int _pixelSize) : renderer(_renderer), font(_font), pixelSize(_pixelSize) {
+        build();
+    }
+
+    GlyphAtlas(const GlyphAtlas&) = delete;
+    GlyphAtlas& operator=(const GlyphAtlas&) = delete;
+
+    // The atlas for a font at a pixel size, built the first time it is asked for
+    static std::shared_ptr<GlyphAtlas> get(SDL_Renderer* renderer, TTF_Font* font, int pixelSize);
+
+    // Drops every atlas (this must happen before their fonts are closed)
+    static void releaseAll();
+
+    // The glyph of a character (nullptr if the font doesn't have it)
+    const Glyph* getGlyph(char character) const;
+
+    SDL_Texture* getTexture() const {
+        return texture;
+    }
+
+    int getLineHeight() const {
+        return lineHeight;
+    }
+
+    ~GlyphAtlas();
+};
+
+#endif
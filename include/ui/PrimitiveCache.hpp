@@ -0,0 +1,26 @@
+#ifndef _PRIMITIVE_CACHE_H
+#define _PRIMITIVE_CACHE_H
+
+#include "SDL.h"
+
+#include <map>
+#include <utility>
+
+// PrimitiveCache rasterizes shapes once into white textures (tinted with a colour mod when drawn),
+// so they cost a single copy each frame instead of a draw call per pixel
+class PrimitiveCache {
+    private:
+    static std::map<std::pair<SDL_Renderer*, int>, SDL_Texture*> circles;
+
+    static SDL_Texture* createCircle(SDL_Renderer* renderer, int radius);
+
+    public:
+    // A filled circle with the given radius, 2 * radius pixels wide (nullptr if it couldn't be created).
+    // Pixel (i, j) is set when (i - radius + 1, j - radius + 1) is within radius of the center.
+    static SDL_Texture* getCircle(SDL_Renderer* renderer, int radius);
+
+    // Destroys every cached texture
+    static void releaseAll();
+};
+
+#endif
@@ -5,7 +5,11 @@
 #include "SDL_ttf.h"
 
 #include "physics/Vector2.hpp"
+#include "ui/GlyphAtlas.hpp"
+
+#include <memory>
 #include <string>
+#include <vector>
 
 // Text element centered around the position
 class Text {
@@ -19,13 +23,18 @@ class Text {
 
     std::string text;
 
-    SDL_Texture* generatedTexture = nullptr;
+    // Glyphs of the font at this size, shared by every text using them
+    std::shared_ptr<GlyphAtlas> atlas;
+
+    // One quad per character, pointing into the atlas
+    std::vector<SDL_Vertex> vertices;
+    std::vector<int> indices;
 
-    // Size of the rendered text
-    Vector2 renderedSize;
+    // Does the text need to be laid out again before it is drawn
+    bool needsLayout = true;
 
-    // Generates the texture
-    void generateTexture();
+    // Lays out the quads of the text
+    void layout();
 
     public:
     Text(SDL_Renderer* _renderer, TTF_Font* _font, const Vector2& _position, double _fontSize, SDL_Color _color, std::string _text) :
@@ -37,8 +46,6 @@ class Text {
     const std::string& getText() const { return text; }
 
     void setColor(SDL_Color _color);
-
-    ~Text();
 };
 
-#endif
\ No newline at end of file
+#endif
@@ -5,6 +5,7 @@
 #include "ui/screens/Screen.hpp"
 
 #include "sprites/Spritesheet.hpp"
+#include "sprites/TextureAtlas.hpp"
 
 #include "physics/BoundingBox.hpp"
 
@@ -24,6 +25,12 @@ class GameScreen : public Screen {
     Spritesheet enemybikeSprite;
     // std::unordered_map<uint32_t, SDL_Texture*> tilesetTextures;
 
+    // All of the spritesheets above packed together, with mirrored frames (shared by every game screen)
+    std::shared_ptr<TextureAtlas> atlas;
+
+    // Sprites drawn during a frame, layered and batched when it is flushed
+    RenderQueue renderQueue;
+
     // Offset for drawing
     double scrollOffset = 0;
 
@@ -40,10 +47,17 @@ class GameScreen : public Screen {
     // Is the level complete animation done
     bool finishedLevelComplete = false;
 
+    // Draws the level's pre-rendered chunks, or every tile if the level couldn't be pre-rendered
     void drawLevel(std::shared_ptr<Level> level);
 
+    // Draws the level's tiles one at a time (or just the hitbox tiles)
+    void drawTiles(std::shared_ptr<Level> level, bool hitboxesOnly);
+
     void drawCollisionHitbox(const Vector2& position, const BoundingBox& hitbox) const;
 
+    // Does something centred at the given world position (and this wide) show up on screen
+    bool isOnScreen(const Vector2& position, double width) const;
+
     public:
     GameScreen(SDL_Renderer* _renderer, GameLogic& _gameLogic, TTF_Font* _font) : 
         Screen(_renderer), gameLogic(_gameLogic), font(_font), timeText(
@@ -90,7 +104,18 @@ class GameScreen : public Screen {
             Vector2(32, 32),
             1,
             8
-        )  {
+        ), renderQueue(_renderer)  {
+            atlas = TextureAtlas::get(_renderer, "characters");
+
+            // The sheets are packed by the first game screen, later ones draw from the pages it made
+            for (auto spritesheet : { &playerSprite, &playerProjectileSprite, &enemySprite, &enemybikeSprite, &corgiSprite, &powerupSprite }) {
+                if (!atlas->apply(*spritesheet)) {
+                    atlas->add(*spritesheet, true);
+                }
+            }
+
+            atlas->build(_renderer);
+
             SoundManager::getInstance()->resumeMusic();
             if (gameLogic.getLevelIndex() == 0)
                 SoundManager::getInstance()->playMusic(MusicTrack::LEVEL_1);
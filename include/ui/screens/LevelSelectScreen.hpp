@@ -17,6 +17,9 @@ class LevelSelectScreen : public Screen {
 
     unsigned int levelsUnlocked = 0;
 
+    // Names of the levels, in order
+    const std::string levelNames[5] = { "Monday", "Tuesday", "Wednesday", "Thursday", "Friday" };
+
     // List of level texts (this exists to make drawing them easier)
     std::vector<Text> levelTexts;
 
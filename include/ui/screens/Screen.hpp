@@ -3,6 +3,7 @@
 
 #include "SDL.h"
 // #include <string>
+#include <memory>
 
 #include "GameLogic.hpp"
 #include "ui/Text.hpp"
@@ -15,7 +16,8 @@ class Screen {
     // Reference to the renderer
     SDL_Renderer* renderer;
 
-    SDL_Texture* background = nullptr;
+    // Handle to the background from the resource cache
+    std::shared_ptr<SDL_Texture> background;
 
     public:
     Screen(SDL_Renderer* _renderer) : renderer(_renderer) {}
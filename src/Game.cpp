@@ -1,11 +1,16 @@
 #include "Game.hpp"
 
 #include <algorithm>
+#include <cmath>
 
 #include <iostream>
 
+// Maximum framerate, set to 0 to draw as often as possible
 const int FPS = 60;
-const int FRAMETIME = 1000 / FPS;
+const int FRAMETIME = FPS > 0 ? 1000 / FPS : 0;
+
+// After a long stall, only run this many game ticks to catch up before dropping the remaining time
+const int MAX_TICKS_PER_FRAME = 5;
 
 // Should we print the current framerate
 const bool PRINT_FPS = false;
@@ -25,6 +30,9 @@ void Game::run() {
 
     Uint64 ticks = SDL_GetTicks64();
 
+    // Time (ms) that has passed but hasn't been simulated yet
+    double accumulator = 0;
+
     while (isRunning) {
         // Handle events on queue
         while (SDL_PollEvent(&e) != 0) {
@@ -47,25 +55,42 @@ void Game::run() {
         // Player view handles extra events
         playerView.handleExtraEvents();
 
-        // Draw the player view
-        playerView.draw();
-
         // Get the difference in ticks (ms)
         Uint64 ticks2 = SDL_GetTicks64();
         Uint64 difference = ticks2 - ticks;
         ticks = ticks2;
 
-        gameLogic.runTick(difference);
+        // Run the game in fixed steps so it behaves the same at any framerate
+        double tickLength = 1000.0 / tickRate;
+        int ticksRun = 0;
+
+        accumulator += difference;
+
+        while (accumulator >= tickLength && ticksRun < MAX_TICKS_PER_FRAME) {
+            gameLogic.runTick(tickLength);
+            accumulator -= tickLength;
+            ticksRun++;
+        }
+
+        if (accumulator >= tickLength) {
+            accumulator = fmod(accumulator, tickLength);
+        }
+
+        // Draw the player view partway between the last two ticks (nothing moves while a level is paused)
+        gameLogic.setInterpolation(gameLogic.isLevelActive() ? accumulator / tickLength : 1);
+        playerView.draw();
 
         // FPS printer
         if (PRINT_FPS && difference > 0) {
             // std::cout << difference << std::endl;
-            std::cout << ((float) FRAMETIME) / ((float) difference) * 60.0 << std::endl;
+            std::cout << 1000.0 / ((float) difference) << std::endl;
         }
         
-        // Set to 60 fps
-        if (difference < FRAMETIME) {
-            SDL_Delay(std::max((Uint64) 1, FRAMETIME - difference));
+        // Cap the framerate
+        Uint64 frameTime = SDL_GetTicks64() - ticks;
+
+        if (frameTime < FRAMETIME) {
+            SDL_Delay(std::max((Uint64) 1, FRAMETIME - frameTime));
         }
     }
 }
\ No newline at end of file
@@ -1,15 +1,14 @@
 #include "GameLogic.hpp"
 #include "characters/Player.hpp"
+#include "SoundManager.hpp"
 
 #include "mathutils.hpp"
+#include "gameDimensions.hpp"
 
 #include <fstream>
 #include <memory>
-#include <thread>
-#include <chrono>
 
-GameLogic::GameLogic() {
-  
+GameLogic::GameLogic() : timerWheel(std::make_shared<TimerWheel>()) {
 
     levelData[0] = LevelData("../assets/visual/SunkenGardenLevel.tmx");
     levelData[1] = LevelData("../assets/visual/Level2.tmx");
@@ -41,35 +40,52 @@ void GameLogic::init() {
 
 void GameLogic::runTick(double ms) {
     if (isLevelActive()) {
+        timer->update(ms);
+
+        // Only simulate the entities close to the screen
+        double scrollOffset = getScrollOffset();
+        level->updateActivity(scrollOffset - activityMargin, scrollOffset + WINDOW_WIDTH + activityMargin, ms);
+
+        // Keep the positions from before this tick so that drawing can interpolate between them
+        player->savePreviousPosition();
+
+        level->getEnemies().savePreviousPositions();
+        level->getCorgis().savePreviousPositions();
+        level->getPowerups().savePreviousPositions();
+
+        level->updateSpatialHash();
+
         player->move(ms);
 
-        for (auto enemy : level->getEnemies()) {
-            if (!enemy->getCanShoot()){
-                enemy->moveOnTrack(ms);
-            }
-            
-            enemy->updateProjectiles(ms);
-            bool detected = enemy->detectPlayer(player, ms);
-            if (detected) {
-                enemy->shoot();
+        // Every projectile (from the player and the enemies) moves in a single pass
+        level->getProjectiles().update(*level, ms);
+
+        // Enemies that can shoot decide whether to follow the player or keep patrolling, then everyone patrolling moves at once
+        auto& enemies = level->getEnemies();
+
+        for (size_t idx = 0; idx < enemies.size(); idx++) {
+            if (enemies.hasFlag(idx, ENTITY_ASLEEP)) {
+                continue;
             }
-        }
 
-        for (auto corgi : level->getCorgis()) {
-            corgi->moveOnTrack(ms);
-        }
-        for (auto powerup : level->getPowerups()) {
-            powerup->animate();
+            auto enemy = level->getEnemy(idx);
+
+            enemy.detectPlayer(*this, *player);
         }
 
-        level->removeDeadEnemies();
-        level->removeCollectedPowerups();
+        enemies.moveOnTracks(ms);
+        level->getCorgis().moveOnTracks(ms);
+        level->getPowerups().animate();
+
+        level->removeFinishedEntities();
+
+        timerWheel->advance(ms);
     }
 }
 
 double GameLogic::getScrollOffset() const {
     auto levelWidth = level->getDimensions().getX();
-    auto playerPos = player->getPosition().getX();
+    auto playerPos = player->getInterpolatedPosition(interpolation).getX();
 
     return mathutils::clamp(playerPos - 512, 0, levelWidth - 1024);
 }
@@ -78,10 +94,19 @@ void GameLogic::activate(SDL_Renderer* renderer) {
     level = std::make_shared<Level>();
     // level = std::make_shared<Level>(Vector2(2240, 768)); // In the future this maybe should not be hardcoded
     timer = std::make_shared<TimeKeeper>();
-    std::thread time(&TimeKeeper::beginTimer, timer);
-    time.detach();
+    timer->startTimer();
+
+    // Start the ticking sound once time is running low
+    timer->addListener([](TimeEvent event, int) {
+        if (event == TimeEvent::WARNING) {
+            SoundManager::getInstance()->playSound(SoundEffect::CLOCK_TICK, true);
+        }
+    });
+
+    // Timers from a previous attempt shouldn't carry over
+    timerWheel->clear();
 
-    if (!level->loadData(*this, levelData.at(levelIndex), renderer)) {
+    if (!level->loadData(levelData.at(levelIndex), renderer)) {
         std::cerr << "Failed to load level!" << std::endl;
         return;
     }
@@ -92,6 +117,7 @@ void GameLogic::activate(SDL_Renderer* renderer) {
 
     // player = std::make_shared<Player>(Player(*this, Vector2(500, 500)));
     player = std::make_shared<Player>(Player(*this, spawn));
+    interpolation = 1;
 
     state = GameState::ACTIVE;
 }
@@ -104,8 +130,7 @@ void GameLogic::pause() {
 
 void GameLogic::resume() {
     state = GameState::ACTIVE;
-    std::thread time(&TimeKeeper::beginTimer, timer);
-    time.detach();
+    timer->startTimer();
 }
 
 void GameLogic::quitLevel() {
@@ -0,0 +1,54 @@
+#include "HandleTable.hpp"
+
+void HandleTable::reserve(size_t capacity) {
+    // There are never more slots than entries that were alive at once
+    denseSlots.reserve(capacity);
+    slotIndexes.reserve(capacity);
+    slotGenerations.reserve(capacity);
+    freeSlots.reserve(capacity);
+}
+
+Handle HandleTable::add() {
+    uint32_t slot;
+
+    if (freeSlots.empty()) {
+        slot = slotIndexes.size();
+        slotIndexes.push_back(0);
+        slotGenerations.push_back(0);
+    } else {
+        slot = freeSlots.back();
+        freeSlots.pop_back();
+    }
+
+    slotIndexes[slot] = denseSlots.size();
+    denseSlots.push_back(slot);
+
+    return Handle { slot, slotGenerations[slot] };
+}
+
+void HandleTable::remove(size_t index) {
+    size_t last = denseSlots.size() - 1;
+    uint32_t slot = denseSlots[index];
+
+    // Invalidate every handle to the removed entry
+    slotIndexes[slot] = UINT32_MAX;
+    slotGenerations[slot]++;
+    freeSlots.push_back(slot);
+
+    if (index != last) {
+        denseSlots[index] = denseSlots[last];
+        slotIndexes[denseSlots[index]] = index;
+    }
+
+    denseSlots.pop_back();
+}
+
+void HandleTable::clear() {
+    for (auto slot : denseSlots) {
+        slotIndexes[slot] = UINT32_MAX;
+        slotGenerations[slot]++;
+        freeSlots.push_back(slot);
+    }
+
+    denseSlots.clear();
+}
@@ -4,6 +4,11 @@
 #include "gameDimensions.hpp"
 #include "sdlLogging.hpp"
 #include "SoundManager.hpp"
+#include "ResourceCache.hpp"
+#include "TextureResidency.hpp"
+#include "sprites/TextureAtlas.hpp"
+#include "ui/GlyphAtlas.hpp"
+#include "ui/PrimitiveCache.hpp"
 #include "ui/screens/GameScreen.hpp"
 #include "ui/screens/LevelSelectScreen.hpp"
 #include "ui/screens/PauseConfirmQuitScreen.hpp"
@@ -14,6 +19,9 @@
 #include "ui/screens/LevelWinScreen.hpp"
 #include "ui/screens/GameFinishScreen.hpp"
 
+// Should we print what the resource cache holds whenever a level starts
+const bool PRINT_RESIDENCY_REPORT = false;
+
 void PlayerView::setupSDL() {
     // Create window
     window = SDL_CreateWindow("Class Dash", SDL_WINDOWPOS_CENTERED, SDL_WINDOWPOS_CENTERED, WINDOW_WIDTH, WINDOW_HEIGHT, SDL_WINDOW_SHOWN);
@@ -44,6 +52,8 @@ void PlayerView::setupSDL() {
 
     if (renderer == NULL)
         sdlError("Could not create renderer!");
+
+    ResourceCache::getInstance()->initialize(renderer);
 }
 
 void PlayerView::init() {
@@ -59,6 +69,9 @@ void PlayerView::draw() {
     screen->draw();
 
     SDL_RenderPresent(renderer);
+
+    // Textures that weren't drawn this frame can be freed if there are too many
+    TextureResidency::getInstance()->endFrame();
 }
 
 void PlayerView::handleEvent(SDL_Event& event) {
@@ -118,8 +131,10 @@ void PlayerView::switchToPauseScreen() {
 void PlayerView::switchToGameScreen() {
     auto& gameLogic = game.getGameLogic();
 
+    bool startingLevel = gameLogic.isNoLevelActive();
+
     // Tell the game logic to update the level
-    if (gameLogic.isNoLevelActive()) {
+    if (startingLevel) {
         game.getGameLogic().activate(renderer);
     } else {
         // If there is a level active, then resume the level
@@ -127,6 +142,10 @@ void PlayerView::switchToGameScreen() {
     }
 
     screen = std::make_unique<GameScreen>(GameScreen(renderer, game.getGameLogic(), font));
+
+    if (PRINT_RESIDENCY_REPORT && startingLevel) {
+        ResourceCache::getInstance()->printResidencyReport(std::cout);
+    }
 }
 
 void PlayerView::switchToPauseConfirmQuitScreen() {
@@ -149,6 +168,10 @@ void PlayerView::switchToGameFinishScreen() {
 
 PlayerView::~PlayerView() {
     // SDL_DestroyTexture(texture);
+    GlyphAtlas::releaseAll();
+    TextureAtlas::releaseAll();
+    PrimitiveCache::releaseAll();
+    ResourceCache::getInstance()->cleanup();
     TTF_CloseFont(font);
     TTF_Quit();
     IMG_Quit();
@@ -0,0 +1,50 @@
+#include "ProjectilePool.hpp"
+
+ProjectileHandle ProjectilePool::spawn(const Projectile& projectile) {
+    if (projectiles.size() >= PROJECTILE_POOL_CAPACITY) {
+        return ProjectileHandle();
+    }
+
+    projectiles.push_back(projectile);
+    return handles.add();
+}
+
+size_t ProjectilePool::countOwnedBy(ProjectileOwner owner, EntityHandle shooter) const {
+    size_t count = 0;
+
+    for (auto& projectile : projectiles) {
+        if (projectile.isActive() && projectile.getOwner() == owner) {
+            if (owner == ProjectileOwner::PLAYER || projectile.getShooter() == shooter) {
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+void ProjectilePool::update(WorldQuery& world, double ms) {
+    for (auto& projectile : projectiles) {
+        if (projectile.isActive()) {
+            projectile.move(world, ms);
+        }
+    }
+}
+
+void ProjectilePool::compact() {
+    auto isDead = [this](size_t index) {
+        return !projectiles[index].isActive();
+    };
+
+    auto moveProjectile = [this](size_t from, size_t to) {
+        projectiles[to] = projectiles[from];
+    };
+
+    handles.compact(isDead, moveProjectile);
+    projectiles.erase(projectiles.begin() + handles.size(), projectiles.end());
+}
+
+void ProjectilePool::clear() {
+    handles.clear();
+    projectiles.clear();
+}
@@ -0,0 +1,221 @@
+#include "ResourceCache.hpp"
+#include "TextureResidency.hpp"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+// Initialize static instance
+ResourceCache* ResourceCache::instance = nullptr;
+
+ResourceCache* ResourceCache::getInstance() {
+    if (instance == nullptr) {
+        instance = new ResourceCache();
+    }
+    return instance;
+}
+
+void ResourceCache::initialize(SDL_Renderer* _renderer) {
+    renderer = _renderer;
+}
+
+SDL_Surface* ResourceCache::decode(const ResourceKey& key) {
+    auto loaded = IMG_Load(key.path.c_str());
+
+    if (loaded == NULL) {
+        std::cerr << "Could not load " << key.path << ": " << IMG_GetError() << std::endl;
+        return nullptr;
+    }
+
+    decodes++;
+
+    auto converted = SDL_ConvertSurfaceFormat(loaded, key.format, 0);
+    SDL_FreeSurface(loaded);
+
+    if (converted == NULL || key.scale == 1.0) {
+        return converted;
+    }
+
+    int width = std::max(static_cast<int>(std::round(converted->w * key.scale)), 1);
+    int height = std::max(static_cast<int>(std::round(converted->h * key.scale)), 1);
+    auto scaled = SDL_CreateRGBSurfaceWithFormat(0, width, height, SDL_BITSPERPIXEL(key.format), key.format);
+
+    if (scaled != NULL) {
+        // Copy the pixels as they are, alpha included
+        SDL_SetSurfaceBlendMode(converted, SDL_BLENDMODE_NONE);
+        SDL_BlitScaled(converted, NULL, scaled, NULL);
+    }
+
+    SDL_FreeSurface(converted);
+    return scaled;
+}
+
+void ResourceCache::load(const ResourceKey& key, SurfaceEntry& entry) {
+    auto surface = decode(key);
+
+    if (surface == nullptr) {
+        return;
+    }
+
+    entry.surface = std::shared_ptr<SDL_Surface>(surface, SDL_FreeSurface);
+    entry.evicted = false;
+
+    // Only surfaces nothing else is holding on to can be freed, they are decoded from the file again when they are next asked for
+    TextureResidency::getInstance()->add(surface, (size_t) surface->pitch * surface->h, [this, key]() {
+        auto& evicted = surfaces[key];
+
+        if (evicted.surface.use_count() > 1) {
+            return false;
+        }
+
+        evicted.surface.reset();
+        evicted.evicted = true;
+        return true;
+    });
+}
+
+std::shared_ptr<SDL_Surface> ResourceCache::getSurface(const std::string& path, Uint32 format, double scale) {
+    auto key = ResourceKey { path, format, scale };
+    auto found = surfaces.find(key);
+
+    // Images that failed to load are remembered too, so they aren't read from disk again every frame
+    if (found == surfaces.end()) {
+        load(key, surfaces[key]);
+        found = surfaces.find(key);
+    } else if (found->second.evicted) {
+        load(key, found->second);
+    }
+
+    auto& entry = found->second;
+    entry.requests++;
+
+    if (entry.surface) {
+        TextureResidency::getInstance()->touch(entry.surface.get());
+    }
+
+    return entry.surface;
+}
+
+void ResourceCache::upload(const ResourceKey& key, TextureEntry& entry) {
+    auto surface = getSurface(key.path, key.format, key.scale);
+
+    if (surface == nullptr) {
+        return;
+    }
+
+    auto texture = SDL_CreateTextureFromSurface(renderer, surface.get());
+
+    if (texture == NULL) {
+        std::cerr << "Could not create texture for " << key.path << ": " << SDL_GetError() << std::endl;
+        return;
+    }
+
+    uploads++;
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    entry.texture = std::shared_ptr<SDL_Texture>(texture, SDL_DestroyTexture);
+    entry.width = surface->w;
+    entry.height = surface->h;
+    entry.evicted = false;
+
+    // Only textures nothing else is holding on to can be freed, they are uploaded again from the surface when they are next asked for
+    TextureResidency::getInstance()->add(texture, (size_t) entry.width * entry.height * SDL_BYTESPERPIXEL(key.format), [this, key]() {
+        auto& evicted = textures[key];
+
+        if (evicted.texture.use_count() > 1) {
+            return false;
+        }
+
+        evicted.texture.reset();
+        evicted.evicted = true;
+        return true;
+    });
+}
+
+std::shared_ptr<SDL_Texture> ResourceCache::getTexture(const std::string& path, Uint32 format, double scale) {
+    auto key = ResourceKey { path, format, scale };
+    auto found = textures.find(key);
+
+    if (found == textures.end()) {
+        upload(key, textures[key]);
+        found = textures.find(key);
+    } else if (found->second.evicted) {
+        upload(key, found->second);
+    }
+
+    auto& entry = found->second;
+    entry.requests++;
+
+    if (entry.texture) {
+        TextureResidency::getInstance()->touch(entry.texture.get());
+    }
+
+    return entry.texture;
+}
+
+void ResourceCache::printResidencyReport(std::ostream& out) const {
+    size_t surfaceBytes = 0;
+    size_t textureBytes = 0;
+
+    out << "Resource cache: " << decodes << " decodes, " << uploads << " uploads" << std::endl;
+
+    // Handles held outside the cache, the cache's own reference doesn't count
+    for (const auto& pair : surfaces) {
+        auto& surface = pair.second.surface;
+
+        if (!surface) {
+            out << "  surface " << pair.first.path << " x" << pair.first.scale << ": " << (pair.second.evicted ? "freed" : "failed") << ", "
+                << pair.second.requests << " requests" << std::endl;
+            continue;
+        }
+
+        size_t bytes = (size_t) surface->pitch * surface->h;
+        surfaceBytes += bytes;
+
+        out << "  surface " << pair.first.path << " x" << pair.first.scale << ": " << bytes / 1024 << " KB, "
+            << surface.use_count() - 1 << " held, " << pair.second.requests << " requests" << std::endl;
+    }
+
+    for (const auto& pair : textures) {
+        auto& texture = pair.second.texture;
+
+        if (!texture) {
+            out << "  texture " << pair.first.path << " x" << pair.first.scale << ": " << (pair.second.evicted ? "freed" : "failed") << ", "
+                << pair.second.requests << " requests" << std::endl;
+            continue;
+        }
+
+        size_t bytes = (size_t) pair.second.width * pair.second.height * SDL_BYTESPERPIXEL(pair.first.format);
+        textureBytes += bytes;
+
+        out << "  texture " << pair.first.path << " x" << pair.first.scale << ": " << bytes / 1024 << " KB, "
+            << texture.use_count() - 1 << " held, " << pair.second.requests << " requests" << std::endl;
+    }
+
+    auto residency = TextureResidency::getInstance();
+
+    out << "  total: " << surfaceBytes / 1024 << " KB of surfaces, " << textureBytes / 1024 << " KB of textures" << std::endl;
+    out << "  resident: " << residency->getResidentBytes() / 1024 << " KB of every texture and surface (budget " << residency->getBudget() / 1024
+        << " KB), " << residency->getEvictions() << " freed so far" << std::endl;
+}
+
+void ResourceCache::cleanup() {
+    for (auto& pair : textures) {
+        if (pair.second.texture) {
+            TextureResidency::getInstance()->remove(pair.second.texture.get());
+        }
+    }
+
+    for (auto& pair : surfaces) {
+        if (pair.second.surface) {
+            TextureResidency::getInstance()->remove(pair.second.surface.get());
+        }
+    }
+
+    textures.clear();
+    surfaces.clear();
+}
+
+ResourceCache::~ResourceCache() {
+    cleanup();
+}
@@ -0,0 +1,77 @@
+#include "TextureResidency.hpp"
+
+#include <algorithm>
+
+// Initialize static instance
+TextureResidency* TextureResidency::instance = nullptr;
+
+TextureResidency* TextureResidency::getInstance() {
+    if (instance == nullptr) {
+        instance = new TextureResidency();
+    }
+    return instance;
+}
+
+void TextureResidency::add(const void* key, size_t bytes, std::function<bool()> evict) {
+    remove(key);
+
+    residents[key] = Resident { bytes, frame, evict };
+    residentBytes += bytes;
+}
+
+void TextureResidency::touch(const void* key) {
+    auto found = residents.find(key);
+
+    if (found != residents.end()) {
+        found->second.lastUsedFrame = frame;
+    }
+}
+
+void TextureResidency::remove(const void* key) {
+    auto found = residents.find(key);
+
+    if (found != residents.end()) {
+        residentBytes -= found->second.bytes;
+        residents.erase(found);
+    }
+}
+
+void TextureResidency::enforceBudget() {
+    if (residentBytes <= budget || (overBudget && residentBytes == overBudgetBytes)) {
+        return;
+    }
+
+    // Textures drawn this frame are on screen, so they are never freed
+    candidates.clear();
+
+    for (const auto& pair : residents) {
+        if (pair.second.evict && pair.second.lastUsedFrame < frame) {
+            candidates.emplace_back(pair.second.lastUsedFrame, pair.first);
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const auto& candidate : candidates) {
+        if (residentBytes <= budget) {
+            break;
+        }
+
+        auto found = residents.find(candidate.second);
+
+        // The evict function can't unregister the texture itself, that is done here
+        if (found->second.evict()) {
+            residentBytes -= found->second.bytes;
+            residents.erase(found);
+            evictions++;
+        }
+    }
+
+    overBudget = residentBytes > budget;
+    overBudgetBytes = residentBytes;
+}
+
+void TextureResidency::endFrame() {
+    enforceBudget();
+    frame++;
+}
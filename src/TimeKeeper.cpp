@@ -1,94 +1,58 @@
 #include "TimeKeeper.hpp"
-#include "SoundManager.hpp"
 
-#include <thread>
-#include <chrono>
-#include <iostream>
+#include <cmath>
 
 TimeKeeper::TimeKeeper() {
     SDL_Init(SDL_INIT_TIMER);
 
     startTime = 60;
-    timeElapsed = startTime;
-    endTime = 0;
+    timeLeft = startTime * 1000.0;
     minutes = startTime / 60;
     seconds = 0;
     timeRunning = false;
-    timeElapsed = startTime;
 }
 
-void TimeKeeper::beginTimer() {
-    timeRunning = true;
-    warnTime = 60;
-    while (timeRunning == true) {
-        if (timeElapsed > 0) {
-            iterations++;
+void TimeKeeper::update(double ms) {
+    if (!timeRunning) {
+        return;
+    }
 
-            if (iterations >= 20) { // 20 = 1000 / 50
-                timeElapsed -= 1;
-                minutes = timeElapsed / 60;
-                seconds = timeElapsed % 60;
-                iterations = 0;
+    timeLeft = std::max(0.0, timeLeft - ms);
+    penaltyWarning = std::max(0.0, penaltyWarning - ms);
 
-                // Turn off warning after player is hit
-                if (abs(timeElapsed - warnTime) > 1) {
-                    isWarning = false;
-                }
+    updateDisplay();
+}
 
-                if (timeElapsed <= 10) { // length
-                    isWarning = true;
+void TimeKeeper::subtractTime(int _seconds) {
+    timeLeft = std::max(0.0, timeLeft - _seconds * 1000.0);
+    penaltyWarning = PENALTY_WARNING_LENGTH;
 
-                    // std::cout << "play sound" << std::endl;
+    notify(TimeEvent::PENALTY, _seconds);
+    updateDisplay();
+}
 
-                    if (!playedWarnSound) {
-                        SoundManager::getInstance()->playSound(SoundEffect::CLOCK_TICK, true);
-                        playedWarnSound = true;
-                    }
-                }
-            }
-        }
-        else {
-            minutes = 0;
-            seconds = 0;
-        }
+void TimeKeeper::updateDisplay() {
+    // Show whole seconds, rounding up so the clock only reads 0 once the time is actually up
+    int secondsLeft = (int) ceil(timeLeft / 1000);
 
-        // More accurate timekeeping
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    }
+    minutes = secondsLeft / 60;
+    seconds = secondsLeft % 60;
 
-/*
-    std::this_thread::sleep_for(std::chrono::seconds(1));
-    if (timeElapsed > 0) {
-            timeElapsed -= 1;
-            minutes = timeElapsed / 60;
-            seconds = timeElapsed % 60;
-        }
-        else {
-            minutes = 0;
-            seconds = 0;
-        }
-*/
-    /*
-    timeElapsed = ((SDL_GetTicks64() - startTime) / 1000);
-    minutes = (timeElapsed / 60);
-    seconds = (timeElapsed % 60);
-    */
-}
+    if (secondsLeft <= WARNING_TIME && !sentWarning) {
+        sentWarning = true;
+        notify(TimeEvent::WARNING, secondsLeft);
+    }
 
-void TimeKeeper::subtractTime(int _seconds) {
-    timeElapsed -= _seconds;
-    minutes = timeElapsed / 60;
-    seconds = timeElapsed % 60;
-    isWarning = true;
-    warnTime = timeElapsed;
+    if (isTimeUp() && !sentTimeUp) {
+        sentTimeUp = true;
+        notify(TimeEvent::TIME_UP, 0);
+    }
 }
 
-void TimeKeeper::resetTimer() {
-    endTime = timeElapsed;
-    /*
-    endTime = SDL_GetTicks64();
-    startTime = SDL_GetTicks64();
-    */
+void TimeKeeper::notify(TimeEvent event, int eventSeconds) {
+    for (auto& listener : listeners) {
+        listener(event, eventSeconds);
+    }
 }
 
 std::string TimeKeeper::getTime() const {
@@ -0,0 +1,169 @@
+#include "TimerWheel.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+// Furthest a timer can be placed ahead of the current time, anything later is cascaded down once it gets closer
+const uint64_t MAX_TIMER_DELTA = (1ull << (TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOT_BITS)) - 1;
+
+TimerWheel::TimerWheel() {
+    std::fill(std::begin(slotHeads), std::end(slotHeads), -1);
+}
+
+void TimerWheel::link(uint32_t index) {
+    auto& timer = timers[index];
+    uint64_t delta = std::min(timer.expiry - currentTime, MAX_TIMER_DELTA);
+    uint64_t target = currentTime + delta;
+
+    // Use the lowest wheel whose range covers the delay
+    int level = 0;
+
+    while (level < TIMER_WHEEL_LEVELS - 1 && delta >= (1ull << ((level + 1) * TIMER_WHEEL_SLOT_BITS))) {
+        level++;
+    }
+
+    int slot = level * TIMER_WHEEL_SLOTS + ((target >> (level * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOTS - 1));
+
+    timer.slot = slot;
+    timer.prev = -1;
+    timer.next = slotHeads[slot];
+
+    if (timer.next != -1) {
+        timers[timer.next].prev = index;
+    }
+
+    slotHeads[slot] = index;
+}
+
+void TimerWheel::unlink(uint32_t index) {
+    auto& timer = timers[index];
+
+    if (timer.prev != -1) {
+        timers[timer.prev].next = timer.next;
+    } else {
+        slotHeads[timer.slot] = timer.next;
+    }
+
+    if (timer.next != -1) {
+        timers[timer.next].prev = timer.prev;
+    }
+
+    timer.slot = -1;
+    timer.prev = -1;
+    timer.next = -1;
+}
+
+void TimerWheel::release(uint32_t index) {
+    auto& timer = timers[index];
+
+    timer.callback = nullptr;
+    timer.generation++;
+    freeTimers.push_back(index);
+}
+
+bool TimerWheel::isValid(TimerHandle handle) const {
+    return handle.index < timers.size() && timers[handle.index].generation == handle.generation && timers[handle.index].slot != -1;
+}
+
+TimerHandle TimerWheel::schedule(double delay, std::function<void()> callback) {
+    uint32_t index;
+
+    if (freeTimers.empty()) {
+        index = timers.size();
+        timers.emplace_back();
+    } else {
+        index = freeTimers.back();
+        freeTimers.pop_back();
+    }
+
+    auto& timer = timers[index];
+
+    // A timer always waits at least 1 ms, since the current slot has already been handled
+    timer.expiry = currentTime + std::max((uint64_t) 1, (uint64_t) ceil(delay));
+    timer.callback = std::move(callback);
+    link(index);
+
+    return TimerHandle { index, timer.generation };
+}
+
+bool TimerWheel::cancel(TimerHandle handle) {
+    if (!isValid(handle)) {
+        return false;
+    }
+
+    unlink(handle.index);
+    release(handle.index);
+
+    return true;
+}
+
+bool TimerWheel::extend(TimerHandle handle, double delay) {
+    if (!isValid(handle)) {
+        return false;
+    }
+
+    unlink(handle.index);
+    timers[handle.index].expiry = currentTime + std::max((uint64_t) 1, (uint64_t) ceil(delay));
+    link(handle.index);
+
+    return true;
+}
+
+void TimerWheel::step() {
+    currentTime++;
+
+    // Whenever a wheel wraps around, spread the next slot of the wheel above it across the lower wheels.
+    // This goes from the top down so that timers cascaded from a high wheel are not dropped into a slot that was already handled.
+    int wrapped = 0;
+
+    while (wrapped < TIMER_WHEEL_LEVELS - 1 && (currentTime & ((1ull << ((wrapped + 1) * TIMER_WHEEL_SLOT_BITS)) - 1)) == 0) {
+        wrapped++;
+    }
+
+    for (int level = wrapped; level >= 1; level--) {
+        int slot = level * TIMER_WHEEL_SLOTS + ((currentTime >> (level * TIMER_WHEEL_SLOT_BITS)) & (TIMER_WHEEL_SLOTS - 1));
+        int32_t index = slotHeads[slot];
+        slotHeads[slot] = -1;
+
+        while (index != -1) {
+            int32_t next = timers[index].next;
+            link(index);
+            index = next;
+        }
+    }
+
+    // Fire everything in the current slot. Callbacks may schedule or cancel timers, so take them off one at a time.
+    int slot = currentTime & (TIMER_WHEEL_SLOTS - 1);
+
+    while (slotHeads[slot] != -1) {
+        uint32_t index = slotHeads[slot];
+        auto callback = std::move(timers[index].callback);
+
+        unlink(index);
+        release(index);
+
+        if (callback) {
+            callback();
+        }
+    }
+}
+
+void TimerWheel::advance(double ms) {
+    remainder += ms;
+
+    while (remainder >= 1) {
+        remainder -= 1;
+        step();
+    }
+}
+
+void TimerWheel::clear() {
+    for (uint32_t index = 0; index < timers.size(); index++) {
+        if (timers[index].slot != -1) {
+            unlink(index);
+            release(index);
+        }
+    }
+
+    remainder = 0;
+}
@@ -5,142 +5,108 @@
 #include <cmath>
 
 
-std::deque<EnemyProjectile> enemyProjectiles;
-SDL_TimerID enemyProjectileTimerID;
-bool isEnemyProjectileTimerActive = false;
+void Enemy::shoot(GameLogic& gameLogic) {
 
-void Enemy::move(double ms) {
-    Character::move(ms);
-}
-
-// Callback for the projectile timer
-Uint32 onEnemyProjectileTimer(Uint32 interval, void *param) {
-    auto* enemy = reinterpret_cast<Enemy*>(param);
-
-    enemy->setIfProjectileTimerActive(false);
-
-    return 0; // Don't repeat
-}
-
-void Enemy::shoot() {
-
-    if (!canShoot) {
+    if (!getCanShoot()) {
         return;
     }
 
-    if (isEnemyProjectileTimerActive) {
+    if (store.hasFlag(index, ENTITY_COOLDOWN)) {
         return;
     }
 
-    // shoots a projectile at the player
-    EnemyProjectile enemyProjectile = EnemyProjectile(std::make_shared<GameLogic>(gameLogic), playerLoc, position);
+    // shoots a projectile at the player, if this enemy doesn't already have too many in the level
+    auto& projectiles = gameLogic.getLevel()->getProjectiles();
+    auto handle = getHandle();
 
-    // Add to the list of projectiles if there aren't already too many
-    if (enemyProjectiles.size() < MAX_ENEMY_PROJECTILES) {
-        enemyProjectiles.push_back(enemyProjectile);
+    if (projectiles.countOwnedBy(ProjectileOwner::ENEMY, handle) < MAX_ENEMY_PROJECTILES) {
+        auto velocity = (store.targets[index] - getPosition()).normal() * PROJECTILE_SPEED;
+        projectiles.spawn(Projectile(ProjectileOwner::ENEMY, getPosition(), velocity, handle));
     }
 
-    // Set up the projectile timer
-    isEnemyProjectileTimerActive = true;
-    enemyProjectileTimerID = SDL_AddTimer(ENEMY_PROJECTILE_DELAY, onEnemyProjectileTimer, this);
+    // Set up the projectile timer, the handle makes sure the enemy is still around when it ends
+    auto& enemyStore = store;
 
-}
-
-void Enemy::moveOnTrack(double ms) {
-    //moving = true;
-    
-    if (currentDirection == MoveDirection::NONE) {
-        velocity.setX(0);
-        moving = false;
-        return;
-    }
-    
-    // Made it to the left end of the track
-    if (position.getX() <= trackStart) {
-        moveRight();
-    }
-    // Made it to the right end of the track
-    else if (position.getX() >= trackEnd) {
-        moveLeft();
-    }
-    
-    // Placeholder until collision added ------
-    if (position.getY() >= groundLevel) {
-        velocity.setY(0);
-        position.setY(groundLevel);
-    }
-    //------------
+    store.setFlag(index, ENTITY_COOLDOWN, true);
+    store.cooldownTimers[index] = gameLogic.getTimerWheel()->schedule(ENEMY_PROJECTILE_DELAY, [&enemyStore, handle] {
+        if (enemyStore.isValid(handle)) {
+            enemyStore.setFlag(enemyStore.indexOf(handle), ENTITY_COOLDOWN, false);
+        }
+    });
 
-    Character::move(ms);
-    if (moving) {
-        animationTicks++;
-    }
 }
 
-void Enemy::moveToPlayer(std::shared_ptr<Player> player) {
+void Enemy::moveToPlayer() {
+    auto& position = store.positions[index];
+    auto& playerLoc = store.targets[index];
+    auto& velocity = store.velocities[index];
+
     // if really close to player, stop walking
-    if (abs(playerLoc.getX() - getPosition().getX()) <= 50) {
-        currentDirection = MoveDirection::NONE;
+    if (abs(playerLoc.getX() - position.getX()) <= 50) {
+        store.currentDirections[index] = MoveDirection::NONE;
         velocity.setX(0);
-        moving = false;
+        store.setFlag(index, ENTITY_MOVING, false);
         return;
     }
     // if at the ends of the track while following, stop
-    else if (playerLoc.getX() <= getPosition().getX()) {
-        if (abs(position.getX() - trackStart) <= 5) {
-            currentDirection = MoveDirection::NONE;
+    else if (playerLoc.getX() <= position.getX()) {
+        if (abs(position.getX() - store.trackStarts[index]) <= 5) {
+            store.currentDirections[index] = MoveDirection::NONE;
             velocity.setX(0);
-            moving = false;
+            store.setFlag(index, ENTITY_MOVING, false);
             return;
         }
         else {
             moveLeft();
-            moving = true;
+            store.setFlag(index, ENTITY_MOVING, true);
             return;
         }
     }
     else { 
-        if (abs(position.getX() - trackEnd) <= 5) {
-            currentDirection = MoveDirection::NONE;
+        if (abs(position.getX() - store.trackEnds[index]) <= 5) {
+            store.currentDirections[index] = MoveDirection::NONE;
             velocity.setX(0);
-            moving = false;
+            store.setFlag(index, ENTITY_MOVING, false);
             return;
         }
         else {
             moveRight();
-            moving = true;
+            store.setFlag(index, ENTITY_MOVING, true);
             return;
         }
     }
-    moving = true;
 }
 
-bool Enemy::detectPlayer(std::shared_ptr<Player> player, double ms) {
-    if (!canShoot) {
+bool Enemy::detectPlayer(GameLogic& gameLogic, const Player& player) {
+    if (!getCanShoot()) {
         return false; // the enemy is blind
     }
 
    // check if player is in range
-   playerLoc = player->getPosition();
+   auto& playerLoc = store.targets[index];
+   playerLoc = player.getPosition();
    Vector2 difference = playerLoc - getPosition();
 
    //check if x axis in range
-   if ((difference.getX() >= -detectRange) && (difference.getX() < detectRange)) {
-       //check if y axis is in range
-       if ((difference.getY() >= -detectRange) && (difference.getY() < detectRange)) {
-           // when in range move to player and shoot
-           moveToPlayer(player);
-           shoot();
+   if ((difference.getX() >= -ENEMY_DETECT_RANGE) && (difference.getX() < ENEMY_DETECT_RANGE)) {
+       //check if y axis is in range, and that there isn't a wall in the way
+       if ((difference.getY() >= -ENEMY_DETECT_RANGE) && (difference.getY() < ENEMY_DETECT_RANGE) && gameLogic.getLevel()->hasLineOfSight(getPosition(), playerLoc)) {
+           // when in range move to player and shoot (following the player replaces walking the track this tick)
+           store.setFlag(index, ENTITY_PATROLLING, false);
+           moveToPlayer();
+           shoot(gameLogic);
            return true;
        }
    } 
-   moveOnTrack(ms);
+   store.setFlag(index, ENTITY_PATROLLING, true);
    return false;
 }
 
 BoundingBox Enemy::getHitbox() const {
     // The hitbox is different if the enemy is flipped
-    if (lastDirection == MoveDirection::RIGHT) {
+    auto& hitbox = store.hitboxes[index];
+
+    if (getLastDirection() == MoveDirection::RIGHT) {
         return hitbox;
     } else {
         auto oldOffset = hitbox.getOffset();
@@ -153,40 +119,13 @@ BoundingBox Enemy::getHitbox() const {
 }
 // Switch Directions on path
 void Enemy::moveLeft() {
-    velocity.setX(-120);
-    currentDirection = MoveDirection::LEFT;
-    lastDirection = MoveDirection::LEFT;
+    store.velocities[index].setX(-TRACK_SPEED);
+    store.currentDirections[index] = MoveDirection::LEFT;
+    store.lastDirections[index] = MoveDirection::LEFT;
 }
 
 void Enemy::moveRight() {
-    velocity.setX(120);
-    currentDirection = MoveDirection::RIGHT;
-    lastDirection = MoveDirection::RIGHT;
-}
-
-
-void Enemy::updateProjectiles(double ms) {
-    // Move the projectiles, while marking any which should be deleted
-    std::vector<size_t> toDelete;
-
-    for (size_t idx = 0; idx < enemyProjectiles.size(); idx++) {
-        auto& proj = enemyProjectiles[idx];
-
-        if (proj.isActive()) {
-            proj.move(ms);
-        } else {
-            toDelete.push_back(idx);
-        }
-    }
-
-    // Delete the corresponding indexes
-    if (toDelete.size() > 0) {
-        // This is needed to keep the indexes accurate
-        int deleted = 0;
-
-        for (auto idx : toDelete) {
-            enemyProjectiles.erase(enemyProjectiles.begin() + idx - deleted);
-            deleted++;
-        }
-    }
+    store.velocities[index].setX(TRACK_SPEED);
+    store.currentDirections[index] = MoveDirection::RIGHT;
+    store.lastDirections[index] = MoveDirection::RIGHT;
 }
\ No newline at end of file
@@ -0,0 +1,215 @@
+#include "characters/EntityStore.hpp"
+#include "physics/physicsConstants.hpp"
+#include "mathutils.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+// Drops everything past the first count elements of a component array
+template <typename T>
+static void truncateColumn(std::vector<T>& column, size_t count) {
+    column.erase(column.begin() + count, column.end());
+}
+
+EntityHandle EntityStore::add(const Vector2& position, double trackStart, double trackEnd, const BoundingBox& hitbox, uint8_t entityFlags, int textureOffset) {
+    positions.push_back(position);
+    previousPositions.push_back(position);
+    velocities.push_back(Vector2((entityFlags & ENTITY_PATROLLING) ? TRACK_SPEED : 0, 0));
+    trackStarts.push_back(trackStart);
+    trackEnds.push_back(trackEnd);
+    groundLevels.push_back(DEFAULT_GROUND_LEVEL);
+    hitboxes.push_back(hitbox);
+    healths.push_back(ENTITY_HEALTH);
+    animationTicks.push_back(0);
+    textureOffsets.push_back(textureOffset);
+    currentDirections.push_back(MoveDirection::RIGHT);
+    lastDirections.push_back(MoveDirection::RIGHT);
+    flags.push_back(entityFlags | ENTITY_MOVING | ENTITY_ACTIVE);
+    sleepStarts.push_back(0);
+    targets.push_back(Vector2());
+    cooldownTimers.push_back(TimerHandle());
+
+    return handles.add();
+}
+
+void EntityStore::compact() {
+    auto isDead = [this](size_t index) {
+        return healths[index] <= 0 || !(flags[index] & ENTITY_ACTIVE);
+    };
+
+    auto moveEntity = [this](size_t from, size_t to) {
+        positions[to] = positions[from];
+        previousPositions[to] = previousPositions[from];
+        velocities[to] = velocities[from];
+        trackStarts[to] = trackStarts[from];
+        trackEnds[to] = trackEnds[from];
+        groundLevels[to] = groundLevels[from];
+        hitboxes[to] = hitboxes[from];
+        healths[to] = healths[from];
+        animationTicks[to] = animationTicks[from];
+        textureOffsets[to] = textureOffsets[from];
+        currentDirections[to] = currentDirections[from];
+        lastDirections[to] = lastDirections[from];
+        flags[to] = flags[from];
+        sleepStarts[to] = sleepStarts[from];
+        targets[to] = targets[from];
+        cooldownTimers[to] = cooldownTimers[from];
+    };
+
+    handles.compact(isDead, moveEntity);
+    truncate(handles.size());
+}
+
+void EntityStore::clear() {
+    handles.clear();
+    truncate(0);
+}
+
+void EntityStore::truncate(size_t count) {
+    truncateColumn(positions, count);
+    truncateColumn(previousPositions, count);
+    truncateColumn(velocities, count);
+    truncateColumn(trackStarts, count);
+    truncateColumn(trackEnds, count);
+    truncateColumn(groundLevels, count);
+    truncateColumn(hitboxes, count);
+    truncateColumn(healths, count);
+    truncateColumn(animationTicks, count);
+    truncateColumn(textureOffsets, count);
+    truncateColumn(currentDirections, count);
+    truncateColumn(lastDirections, count);
+    truncateColumn(flags, count);
+    truncateColumn(sleepStarts, count);
+    truncateColumn(targets, count);
+    truncateColumn(cooldownTimers, count);
+}
+
+void EntityStore::setGroundLevel(size_t index, double groundLevel) {
+    groundLevels[index] = groundLevel;
+    positions[index].setY(groundLevel);
+    previousPositions[index].setY(groundLevel);
+}
+
+void EntityStore::updateActivity(double windowStart, double windowEnd, double ms) {
+    time += ms;
+    size_t count = size();
+
+    for (size_t idx = 0; idx < count; idx++) {
+        double x = positions[idx].getX();
+        double reachStart = x;
+        double reachEnd = x;
+
+        // A patrolling entity could be anywhere on its track by the time it is looked at again, so it stays awake while any of the track is in the window
+        if (flags[idx] & ENTITY_PATROLLING) {
+            reachStart = std::min(reachStart, trackStarts[idx]);
+            reachEnd = std::max(reachEnd, trackEnds[idx]);
+        }
+
+        bool inWindow = reachEnd >= windowStart && reachStart <= windowEnd;
+
+        if (flags[idx] & ENTITY_ASLEEP) {
+            if (inWindow) {
+                flags[idx] &= ~ENTITY_ASLEEP;
+                advanceOnTrack(idx, time - sleepStarts[idx]);
+            }
+        } else if (!inWindow) {
+            flags[idx] |= ENTITY_ASLEEP;
+            sleepStarts[idx] = time;
+        }
+    }
+}
+
+void EntityStore::advanceOnTrack(size_t index, double ms) {
+    double trackLength = trackEnds[index] - trackStarts[index];
+
+    if (!(flags[index] & ENTITY_PATROLLING) || currentDirections[index] == MoveDirection::NONE || trackLength <= 0) {
+        return;
+    }
+
+    auto& position = positions[index];
+    auto& velocity = velocities[index];
+
+    // Walking back and forth is the same as walking around a loop twice the length of the track,
+    // where the first half is walking right and the second half is walking back left
+    double along = mathutils::clamp(position.getX() - trackStarts[index], 0, trackLength);
+    double loopPosition = currentDirections[index] == MoveDirection::RIGHT ? along : 2 * trackLength - along;
+
+    loopPosition = fmod(loopPosition + TRACK_SPEED * ms / 1000, 2 * trackLength);
+
+    if (loopPosition <= trackLength) {
+        position.setX(trackStarts[index] + loopPosition);
+        velocity.setX(TRACK_SPEED);
+        currentDirections[index] = MoveDirection::RIGHT;
+        lastDirections[index] = MoveDirection::RIGHT;
+    } else {
+        position.setX(trackStarts[index] + 2 * trackLength - loopPosition);
+        velocity.setX(-TRACK_SPEED);
+        currentDirections[index] = MoveDirection::LEFT;
+        lastDirections[index] = MoveDirection::LEFT;
+    }
+
+    // Sleeping entities have long since landed on the ground
+    position.setY(groundLevels[index]);
+    velocity.setY(0);
+    previousPositions[index] = position;
+}
+
+void EntityStore::savePreviousPositions() {
+    previousPositions = positions;
+}
+
+void EntityStore::moveOnTracks(double ms) {
+    double seconds = ms / 1000;
+    size_t count = size();
+
+    for (size_t idx = 0; idx < count; idx++) {
+        if (!(flags[idx] & ENTITY_PATROLLING) || (flags[idx] & ENTITY_ASLEEP)) {
+            continue;
+        }
+
+        auto& position = positions[idx];
+        auto& velocity = velocities[idx];
+
+        if (currentDirections[idx] == MoveDirection::NONE) {
+            velocity.setX(0);
+            flags[idx] &= ~ENTITY_MOVING;
+            continue;
+        }
+
+        // Turn around at either end of the track
+        if (position.getX() <= trackStarts[idx]) {
+            velocity.setX(TRACK_SPEED);
+            currentDirections[idx] = MoveDirection::RIGHT;
+            lastDirections[idx] = MoveDirection::RIGHT;
+        } else if (position.getX() >= trackEnds[idx]) {
+            velocity.setX(-TRACK_SPEED);
+            currentDirections[idx] = MoveDirection::LEFT;
+            lastDirections[idx] = MoveDirection::LEFT;
+        }
+
+        // Placeholder until collision added ------
+        if (position.getY() >= groundLevels[idx]) {
+            velocity.setY(0);
+            position.setY(groundLevels[idx]);
+        }
+        //------------
+
+        velocity.setY(velocity.getY() + GRAVITY * seconds);
+        position.setX(position.getX() + velocity.getX() * seconds);
+        position.setY(position.getY() + velocity.getY() * seconds);
+
+        if (flags[idx] & ENTITY_MOVING) {
+            animationTicks[idx]++;
+        }
+    }
+}
+
+void EntityStore::animate() {
+    size_t count = size();
+
+    for (size_t idx = 0; idx < count; idx++) {
+        if (!(flags[idx] & ENTITY_ASLEEP)) {
+            animationTicks[idx]++;
+        }
+    }
+}
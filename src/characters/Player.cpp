@@ -10,16 +10,13 @@
 const int GROUND_HEIGHT = 608; //This is just the current ground height based on how player position is called in GameLogic
 const float JUMP_HEIGHT = 100.0f;
 
-int Player::getCurrentAnimationOffset() const {
-    return (animationTicks % 40) / 10;
+// Converts a world coordinate into a tile coordinate
+static int toTile(double coord) {
+    return static_cast<int>(floor(coord / TILE_SIZE));
 }
 
-Uint32 onInvincibilityEnd(Uint32 interval, void *param) {
-    auto* player = reinterpret_cast<Player*>(param);
-
-    player->setInvincible(false);
-
-    return 0;
+int Player::getCurrentAnimationOffset() const {
+    return (animationTicks % 40) / 10;
 }
 
 void Player::move(double ms) {
@@ -36,7 +33,10 @@ void Player::move(double ms) {
         }
     }
 
-    position += velocity * seconds;
+    // Sweep each axis separately so that the player slides along surfaces instead of stopping dead
+    auto displacement = velocity * seconds;
+    moveHorizontally(displacement.getX());
+    moveVertically(displacement.getY());
 
     // Deal with more advanced functionality
     if (currentDirection != MoveDirection::NONE) {
@@ -46,34 +46,89 @@ void Player::move(double ms) {
     handleCollisions();
     checkForFallRespawn();
 
-    // Move the projectiles, while marking any which should be deleted
-    std::vector<size_t> toDelete;
+}
+
+void Player::moveHorizontally(double dx) {
+    auto level = gameLogic.getLevel();
+    auto box = getHitbox();
+
+    if (dx != 0) {
+        auto sweep = level->sweepBox(box + position, Vector2(dx, 0));
 
-    for (size_t idx = 0; idx < projectiles.size(); idx++) {
-        auto& proj = projectiles[idx];
+        if (sweep.hit) {
+            // Stop just short of the wall
+            auto bounds = sweep.object->bounds;
+
+            if (sweep.normal.getX() < 0) {
+                position.setX(bounds.x - box.getRightX() - COLLISION_SKIN);
+            } else {
+                position.setX(bounds.x + bounds.w - box.getLeftX() + COLLISION_SKIN);
+            }
 
-        if (proj.isActive()) {
-            proj.move(ms);
+            velocity.setX(0);
         } else {
-            toDelete.push_back(idx);
+            position.setX(position.getX() + dx);
         }
     }
 
-    // Delete the corresponding indexes
-    if (toDelete.size() > 0) {
-        // This is needed to keep the indexes accurate
-        int deleted = 0;
+    // Check collisions with the side wall
+    if ((box + position).getLeftX() < 0) {
+        position.setX(PLAYER_WIDTH / 2 + 1);
+    }
+}
+
+void Player::moveVertically(double dy) {
+    if (dy == 0) {
+        return;
+    }
 
-        for (auto idx : toDelete) {
-            projectiles.erase(projectiles.begin() + idx - deleted);
-            deleted++;
+    auto level = gameLogic.getLevel();
+    auto box = getHitbox();
+    auto sweep = level->sweepBox(box + position, Vector2(0, dy));
+
+    if (!sweep.hit) {
+        position.setY(position.getY() + dy);
+        return;
+    }
+
+    auto bounds = sweep.object->bounds;
+
+    if (sweep.normal.getY() < 0) {
+        // Landed on top of the collider
+        position.setY(bounds.y - box.getBottomY());
+        velocity.setY(0);
+        isJumping = false;
+        onGround = true;
+        falling = false;
+
+        if (restoreSpeedWhenLand) {
+            isSlowed = false;
+            isFast = false;
+            restoreSpeedWhenLand = false;
         }
+
+        // A jump pressed just before landing happens as soon as the player is on the ground
+        if (bufferedJump) {
+            jump();
+        }
+    } else {
+        // Hit a ceiling, so start falling right away
+        position.setY(bounds.y + bounds.h - box.getTopY() + COLLISION_SKIN);
+        velocity.setY(0.1);
+        falling = true;
     }
 }
 
 void Player::checkForFallRespawn() {
     if (onGround) {
-        respawnPos = position;
+        // Only remember spots where the middle of the player is over the ground, not hanging off the edge of a ledge
+        auto box = getHitbox() + position;
+        double centerX = (box.getLeftX() + box.getRightX()) / 2;
+        double ground = gameLogic.getLevel()->groundBelow(centerX, box.getTopY());
+
+        if (ground >= 0 && ground - box.getBottomY() <= TILE_SIZE) {
+            respawnPos = position;
+        }
     }
 
     if (position.getY() > offMapHeight) {
@@ -93,11 +148,19 @@ void Player::respawn() {
 
     }
 
+    // Stand on the ground under the respawn point, in case moving it back put it somewhere else
+    auto box = getHitbox();
+    double ground = gameLogic.getLevel()->groundBelow(respawnPos.getX() + (box.getLeftX() + box.getRightX()) / 2, respawnPos.getY() + box.getTopY());
+
+    if (ground >= 0) {
+        respawnPos.setY(ground - box.getBottomY());
+    }
+
     gameLogic.getTimer()->subtractTime(10);
-    invincibilityFramesActive = true;
-    invincibilityTimerId = SDL_AddTimer(INVINCIBILITY_FRAMES, onInvincibilityEnd, this);
+    startInvincibility();
 
     position = respawnPos;
+    previousPosition = respawnPos; // Don't slide across the screen to the respawn point
     velocity = Vector2(0, 0);
     onGround=true;
 
@@ -119,13 +182,12 @@ BoundingBox Player::getHitbox() const {
     }
 }
 
-// Callback for the projectile timer
-Uint32 onProjectileTimer(Uint32 interval, void *param) {
-    auto* player = reinterpret_cast<Player*>(param);
-
-    player->setIfProjectileTimerActive(false);
-
-    return 0; // Don't repeat
+void Player::startInvincibility() {
+    invincibilityFramesActive = true;
+    gameLogic.getTimerWheel()->cancel(invincibilityTimer);
+    invincibilityTimer = gameLogic.getTimerWheel()->schedule(INVINCIBILITY_FRAMES, [this] {
+        setInvincible(false);
+    });
 }
 
 void Player::shoot() {
@@ -135,30 +197,23 @@ void Player::shoot() {
 
     SoundManager::getInstance()->playSound(SoundEffect::SHOOT);
 
-    auto newProjectile = Projectile(std::make_shared<GameLogic>(gameLogic), position, currentDirection);
-
-    if (currentDirection == MoveDirection::LEFT) {
-        newProjectile.setStartingPosition(currentDirection);
-        newProjectile.setVelocity(-300, 0);
-    } else if (currentDirection == MoveDirection::RIGHT) {
-        newProjectile.setStartingPosition(currentDirection);
-        newProjectile.setVelocity(300, 0);
-    } else if (lastDirection == MoveDirection::LEFT) {
-        newProjectile.setStartingPosition(lastDirection);
-        newProjectile.setVelocity(-300, 0);
-    } else {
-        newProjectile.setStartingPosition(MoveDirection::RIGHT);
-        newProjectile.setVelocity(300, 0);
-    }
+    // Fire in the direction the player is moving, or was last facing
+    bool shootLeft = currentDirection == MoveDirection::LEFT || (currentDirection == MoveDirection::NONE && lastDirection == MoveDirection::LEFT);
+    double offset = shootLeft ? -20 : 20;
+    double speed = shootLeft ? -PROJECTILE_SPEED : PROJECTILE_SPEED;
+
+    // Add to the level's projectiles if there aren't already too many
+    auto& projectiles = gameLogic.getLevel()->getProjectiles();
 
-    // Add to the list of projectiles if there aren't already too many
-    if (projectiles.size() < MAX_PROJECTILES) {
-        projectiles.push_back(newProjectile);
+    if (projectiles.countOwnedBy(ProjectileOwner::PLAYER) < MAX_PROJECTILES) {
+        projectiles.spawn(Projectile(ProjectileOwner::PLAYER, position + Vector2(offset, 0), Vector2(speed, 0)));
     }
 
     // Set up the projectile timer
     isProjectileTimerActive = true;
-    projectileTimerId = SDL_AddTimer(PROJECTILE_DELAY, onProjectileTimer, this);
+    projectileTimer = gameLogic.getTimerWheel()->schedule(PROJECTILE_DELAY, [this] {
+        setIfProjectileTimerActive(false);
+    });
 }
 
 void Player::stopMoving() {
@@ -194,9 +249,6 @@ void Player::jump() {
         isJumping = true;
         falling = false;
         fallDirection = currentDirection;
-
-        // Fall height isn't applicable
-        fallHeight = -1000;
     } else {
         bufferedJump = true;
     }
@@ -206,17 +258,6 @@ Vector2 Player::getHitboxCenter() const {
     return position + hitbox.getOffset() + hitbox.getSize() / 2.0;
 }
 
-Uint32 onSpeedSlowEnd(Uint32 interval, void *param) {
-    auto* player = reinterpret_cast<Player*>(param);
-    player->restoreSpeed();
-    return 0;
-}
-Uint32 onSpeedFastEnd(Uint32 interval, void *param) {
-    auto* player = reinterpret_cast<Player*>(param);
-    player->restoreSpeed();
-    return 0;
-}
-
 void Player::reduceSpeed() {
     if (!isSlowed) {
         std::cout<<"reducing speed"<<std::endl;
@@ -230,11 +271,11 @@ void Player::reduceSpeed() {
 
         isSlowed = true;
 
-        slowTimerId = SDL_AddTimer(SPEED_FRAMES, onSpeedSlowEnd, this);
+        slowTimer = gameLogic.getTimerWheel()->schedule(SPEED_FRAMES, [this] { restoreSpeed(); });
 
-    } else {
-        SDL_RemoveTimer(slowTimerId);
-        slowTimerId = SDL_AddTimer(SPEED_FRAMES, onSpeedSlowEnd, this);
+    } else if (!gameLogic.getTimerWheel()->extend(slowTimer, SPEED_FRAMES)) {
+        // The timer already ran out while in the air, so start a new one
+        slowTimer = gameLogic.getTimerWheel()->schedule(SPEED_FRAMES, [this] { restoreSpeed(); });
     }
 }
 void Player:: increaseSpeed() {
@@ -249,11 +290,10 @@ void Player:: increaseSpeed() {
 
         isFast = true;
 
-        fastTimerId = SDL_AddTimer(SPEED_FRAMES, onSpeedFastEnd, this);
-    } else {
+        fastTimer = gameLogic.getTimerWheel()->schedule(SPEED_FRAMES, [this] { restoreSpeed(); });
+    } else if (!gameLogic.getTimerWheel()->extend(fastTimer, SPEED_FRAMES)) {
         // If the timer is already on, just extend the timer
-        SDL_RemoveTimer(fastTimerId);
-        fastTimerId = SDL_AddTimer(SPEED_FRAMES, onSpeedFastEnd, this);
+        fastTimer = gameLogic.getTimerWheel()->schedule(SPEED_FRAMES, [this] { restoreSpeed(); });
     }
 }
 void Player::restoreSpeed() {
@@ -277,283 +317,83 @@ float Player::getCurrentSpeed() const {
 }
 
 void Player::handleFloorCollisions() {
-    // If the player is on the ground, confirm that they are still on the ground by checking for a collision
-    // Otherwise, check if the player has collided with the ground. If they have, set them as on the ground and update their position + velocity. If they have a buffered jump, then jump.
-
-    /**
-     * if onGround {
-     *   if player is not on the ground {
-     *     set onGround to false
-     *     set falling to true
-     *   }
-     * } else {
-     *   if player is colliding with the ground {
-     *     if falling and the collided tile is on the same y-level as the original falling location {
-     *       continue
-     *     } else if jumping and not falling {
-     *       continue
-     *     } else if bufferedJump {
-     *       jump (should set isJumping to true)
-     *     } else {
-     *       set position to be on top of the block
-     *       reset vertical velocity
-     *       set onGround to true
-     *     }
-     *   }
-     * }
-     *
-     */
+    // Landing is handled when the player is moved, so this only has to confirm that a grounded player is still on the ground
+    if (!onGround) {
+        return;
+    }
 
     auto hitbox = getHitbox() + position;
-
     auto level = gameLogic.getLevel();
-    auto topY = hitbox.getTopY();
     auto bottomY = hitbox.getBottomY();
-    auto leftX = hitbox.getLeftX();
-    auto rightX = hitbox.getRightX();
-
-    // std::cout << position << ", " << hitbox.getOffset() << std::endl;
 
-     if (onGround) {
-        bool isOnGround = false;
+    bool isOnGround = false;
 
-        for (auto x = leftX; x <= rightX; x += TILE_SIZE / 2) {
-            auto worldTile = level->getWorldCollisionObject(Vector2(floor(x / TILE_SIZE), floor(bottomY / TILE_SIZE)));
+    // Only the first collider under the player matters here
+    int row = toTile(bottomY);
+    int column = level->firstSolidColumn(row, toTile(hitbox.getLeftX()), toTile(hitbox.getRightX()));
 
-            if (worldTile) {
-                if(worldTile->type == "Obstacle") {
-                    reduceSpeed();
-                }
+    if (column != -1) {
+        auto worldTile = level->getWorldCollisionObject(Vector2(column, row));
 
-                if (fabs(worldTile->bounds.y - bottomY) <= 4)
-                    isOnGround = true;
-
-                break;
-            }
-        }
-
-        if (!isOnGround) {
-            // Start falling
-            onGround = false;
-            falling = true;
-            fallDirection = currentDirection;
-            fallHeight = bottomY;
-        }
-     } else {
-        for (auto x = leftX; x <= rightX; x += TILE_SIZE / 2) {
-            auto tileX = floor(x / TILE_SIZE);
-            auto tileY = floor(bottomY / TILE_SIZE);
-            auto worldTile = level->getWorldCollisionObject(Vector2(tileX, tileY));
-
-            // This line is the key
-            if (worldTile) {
-                auto bounds = worldTile->bounds;
-
-                // Check if the player is too far left/right
-                if (bounds.x >= rightX || (bounds.x + bounds.w <= leftX)) {
-                    continue;
-                }
-
-                // If partOfWall is true, then we are against a wall and should not be able to jump or land.
-                auto partOfWall = level->getWorldCollisionObject(Vector2(tileX, tileY - 1));
-
-                auto tilePos = worldTile->bounds;
-
-                // Falling off the same height
-                if (falling && tilePos.y == fallHeight) {
-                    continue;
-                } else if (isJumping && !falling) {
-                    continue;
-                } else if (bufferedJump) {
-                    jump();
-                }
-                // std::cout << tilePos.y << ", " << bottomY << std::endl;
-
-                if (!partOfWall) {
-                    // std::cout << "Hit ground" << std::endl;
-                    position.setY(tilePos.y - PLAYER_HEIGHT / 2);
-                    velocity.setY(0);
-                    isJumping = false;
-                    onGround = true;
-                    falling = false;
-
-                    if (restoreSpeedWhenLand) {
-                        isSlowed = false;
-                        isFast = false;
-                        restoreSpeedWhenLand = false;
-                    }
-                    break;
-                }
-            }
+        if (worldTile->flags & COLLIDER_OBSTACLE) {
+            reduceSpeed();
         }
-     }
-}
-
-void Player::handleCeilingCollisions() {
-    auto hitbox = getHitbox() + position;
-    auto level = gameLogic.getLevel();
-
-    auto hitboxWidth = hitbox.getSize().getX();
-    auto hitboxHeight = hitbox.getSize().getY();
-
-    auto topY = hitbox.getTopY();
-    auto bottomY = hitbox.getBottomY();
-    auto leftX = hitbox.getLeftX();
-    auto rightX = hitbox.getRightX();
-    int unused;
-
-    // The idea is to factor in if the player is moving in a direction
-    for (auto x = (currentDirection == MoveDirection::LEFT ? leftX + 4 : leftX); x <= (currentDirection == MoveDirection::RIGHT ? rightX - 8 : rightX); x += TILE_SIZE / 2) {
-        auto collideWorld = level->getWorldCollisionObject(Vector2(floor(x / TILE_SIZE), floor(topY / TILE_SIZE)));
 
-        if (collideWorld) {
-            auto bounds = collideWorld->bounds;
-
-            // Check if the player is too far left/right
-            if (bounds.x >= rightX || (bounds.x + bounds.w <= leftX)) {
-                continue;
-            }
-
-            // std::cout << "ceiling collision" << std::endl;
-            // position.setX(collideWorld->bounds.x - hitboxWidth);
-            position.setY(collideWorld->bounds.y + collideWorld->bounds.h + PLAYER_HEIGHT / 2 + 1);
-            velocity.setY(0.1);
-            falling = true;
-            break;
-
-        }
+        if (fabs(worldTile->bounds.y - bottomY) <= 4)
+            isOnGround = true;
     }
-}
 
-void Player::handleRightCollisions() {
-    auto hitbox = getHitbox() + position;
-    auto level = gameLogic.getLevel();
-
-    auto hitboxWidth = hitbox.getSize().getX();
-    auto hitboxHeight = hitbox.getSize().getY();
-
-    auto topY = hitbox.getTopY();
-    auto bottomY = hitbox.getBottomY();
-    auto leftX = hitbox.getLeftX();
-    auto rightX = hitbox.getRightX();
-
-    for (auto y = topY; y <= bottomY - 1; y += TILE_SIZE / 2) {
-        auto collideWorld = level -> getWorldCollisionObject(Vector2(floor(rightX / TILE_SIZE), floor(y / TILE_SIZE)));
-
-        if (collideWorld) {
-            auto bounds = collideWorld->bounds;
-
-            // The idea is to not have a collision because the block is too low/high
-            if (bounds.y >= bottomY || (bounds.y + bounds.h <= topY)) {
-                continue;
-            }
-
-            // std::cout<<"Right Collision Detected"<<std::endl;
-            // std::cout<<"X position"<< position.getX()<<" tile X; "<< collideWorld->bounds.x<<"player width" <<hitboxWidth<<" rightX *32 "<<rightX*TILE_SIZE<<std::endl;/
-            // position.setX(collideWorld->bounds.x - hitboxWidth);
-            position.setX(collideWorld->bounds.x - PLAYER_WIDTH / 2 - 1);
-            velocity.setX(0);
-            break;
-
-        }
+    if (!isOnGround) {
+        // Start falling
+        onGround = false;
+        falling = true;
+        fallDirection = currentDirection;
     }
 }
 
-void Player::handleLeftCollisions() {
-    auto hitbox = getHitbox() + position;
+void Player::handleEnemyCollisions() {
     auto level = gameLogic.getLevel();
+    auto playerHitbox = getHitbox() + position;
 
-    auto hitboxWidth = hitbox.getSize().getX();
-    auto hitboxHeight = hitbox.getSize().getY();
-
-    auto topY = hitbox.getTopY();
-    auto bottomY = hitbox.getBottomY();
-    auto leftX = hitbox.getLeftX();
-    auto rightX = hitbox.getRightX();
-
-    // Check collisions with the side wall
-    if (leftX < 0) {
-        position.setX(PLAYER_WIDTH / 2 + 1);
-    }
+    level->getSpatialHash().query(playerHitbox, SPATIAL_ENEMY | SPATIAL_ENEMY_PROJECTILE, nearbyEntities);
 
-    for (auto y = topY; y <= bottomY-1; y += TILE_SIZE / 2) {
-        auto collideWorld = level -> getWorldCollisionObject(Vector2(floor(leftX / TILE_SIZE), floor(y / TILE_SIZE)));
-
-        if (collideWorld) {
-            auto bounds = collideWorld->bounds;
-
-            // The idea is to not have a collision because the block is too low/high
-            if (bounds.y >= bottomY || (bounds.y + bounds.h <= topY)) {
-                continue;
-            }
-
-            // std::cout<<"Left Collision Detected"<<std::endl;
-            // std::cout<<"X position"<< position.getX()<<" tile X; "<< collideWorld->bounds.x+collideWorld->bounds.h<<"player width" <<hitboxWidth<<" leftX*32 "<<leftX*TILE_SIZE<<std::endl;
-            position.setX(collideWorld->bounds.x + collideWorld->bounds.w + PLAYER_WIDTH / 2 + 1);
-            // position.setX(collideWorld->bounds.x+collideWorld->bounds.w+(PLAYER_WIDTH/2)+1);
-            velocity.setX(0);
+    for (auto entry : nearbyEntities) {
+        if (entry->kind != SPATIAL_ENEMY) {
+            continue;
         }
-    }
-}
 
-
-
-
-void Player::handleEnemyCollisions() {
-    auto enemies = gameLogic.getLevel()->getEnemies();
-
-    for (auto enemy : enemies){
-        auto playerHitbox = getHitbox() + position;
-        auto enemyHitbox = enemy->getHitbox() + enemy->getPosition();
+        auto enemy = level->getEnemy(entry->index);
+        auto enemyHitbox = enemy.getHitbox() + enemy.getPosition();
 
         // Detect if the 2 bounding boxes overlap
         if (playerHitbox.overlaps(enemyHitbox)) {
             // std::cout << "enemy collision" << std::endl;
             gameLogic.getTimer()->subtractTime(5); // right now all enemy collisions are 5 seconds
-            invincibilityFramesActive = true;
-            invincibilityTimerId = SDL_AddTimer(INVINCIBILITY_FRAMES, onInvincibilityEnd, this);
+            startInvincibility();
             break;
         }
     }
 
     // Projectile collisions
-    for (auto enemy : enemies) {
-        for (auto& projectile : enemy->getProjectiles()) {
-            auto playerHitbox = getHitbox() + position;
-            auto projHitbox = projectile.getHitbox() + projectile.getPosition();
-
-            if (playerHitbox.overlaps(projHitbox)) {
-                std::cout<<enemy->getPosition().getX()<<"WHY"<<std::endl;
-                reduceSpeed();
-                SoundManager::getInstance()->playSound(SoundEffect::DAMAGE); 
-                projectile.setActive(false);
-            }
+    for (auto entry : nearbyEntities) {
+        if (entry->kind != SPATIAL_ENEMY_PROJECTILE) {
+            continue;
+        }
+
+        auto& projectile = level->getProjectiles()[entry->index];
+        auto projHitbox = projectile.getHitbox() + projectile.getPosition();
+
+        if (playerHitbox.overlaps(projHitbox)) {
+            reduceSpeed();
+            SoundManager::getInstance()->playSound(SoundEffect::DAMAGE); 
+            projectile.setActive(false);
         }
     }
 }
 
 void Player::handleCollisions() {
-    /**
-     * if player is hitting an obstacle to the right and is moving right, push them back
-     * if player is hitting an obstacle to the left and is moving left, push them back
-     * check bottom tiles
-     * check top tiles
-     *
-     * To fix one issue, if the player is falling off of a structure, don't check vertically unless the new position is lower
-     * If the player is jumping, only check vertically once they reach the peak of their jump
-     */
-
-
-     handleFloorCollisions();
-
-     if (velocity.getY() < 0)
-        handleCeilingCollisions();
-
-     if (velocity.getX() > 0) {
-        handleRightCollisions();
-     } else if (velocity.getX() < 0) {
-        handleLeftCollisions();
-     }
+    // Walls, floors and ceilings were already resolved by the swept movement
+    handleFloorCollisions();
 
     if (!invincibilityFramesActive) {
         handleEnemyCollisions();
@@ -569,18 +409,21 @@ void Player::handleCollisions() {
     }
 }
 void Player::handlePowerupCollisions() {
-    auto powerups = gameLogic.getLevel()->getPowerups();
+    auto level = gameLogic.getLevel();
+    auto playerHitbox = getHitbox() + position;
+
+    level->getSpatialHash().query(playerHitbox, SPATIAL_POWERUP, nearbyEntities);
 
-    for (auto powerup : powerups){
-        auto playerHitbox = getHitbox() + position;
-        auto powerupHitbox = powerup->getHitbox() + powerup->getPosition();
+    for (auto entry : nearbyEntities) {
+        auto powerup = level->getPowerup(entry->index);
+        auto powerupHitbox = powerup.getHitbox() + powerup.getPosition();
 
         // Detect if the 2 bounding boxes overlap
         if (playerHitbox.overlaps(powerupHitbox)) {
             std::cout << "powewrup collision" << std::endl;
             increaseSpeed();
             SoundManager::getInstance()->playSound(SoundEffect::POWERUP); 
-            powerup->deactivate();
+            powerup.deactivate();
 
 
         }
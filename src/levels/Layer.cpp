@@ -1,6 +1,8 @@
 #include "levels/Layer.hpp"
 #include "SDL.h"
 
+#include <algorithm>
+
 // gets global ID for a given block
 uint32_t Layer::getID(const Vector2& block) const { 
     for (size_t i = 0; i < blocks.size(); ++i) {
@@ -32,3 +34,49 @@ bool Layer::hasFlipFlag(int index) const {
     return (gid & H_FLIP ) != 0;
 }
 
+void Layer::buildColumnIndex(const std::vector<bool>& hidden) {
+    int columns = 0;
+
+    for (const auto& block : blocks) {
+        columns = std::max(columns, static_cast<int>(std::get<0>(block).getX()) + 1);
+    }
+
+    auto isHidden = [&](size_t i) {
+        return !hidden.empty() && hidden[i];
+    };
+
+    // Count the blocks in each column, then place them (blocks keep their top to bottom order within a column)
+    columnStarts.assign(columns + 1, 0);
+
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (!isHidden(i)) {
+            columnStarts[static_cast<int>(std::get<0>(blocks[i]).getX()) + 1]++;
+        }
+    }
+
+    for (int column = 0; column < columns; column++) {
+        columnStarts[column + 1] += columnStarts[column];
+    }
+
+    std::vector<int> next(columnStarts.begin(), columnStarts.end() - 1);
+    columnBlocks.assign(columnStarts[columns], 0);
+
+    for (size_t i = 0; i < blocks.size(); i++) {
+        if (!isHidden(i)) {
+            columnBlocks[next[static_cast<int>(std::get<0>(blocks[i]).getX())]++] = i;
+        }
+    }
+}
+
+Layer::BlockRange Layer::getBlocksInColumns(int firstColumn, int lastColumn) const {
+    int columns = static_cast<int>(columnStarts.size()) - 1;
+
+    firstColumn = std::max(firstColumn, 0);
+    lastColumn = std::min(lastColumn, columns - 1);
+
+    if (firstColumn > lastColumn) {
+        return BlockRange(columnBlocks.end(), columnBlocks.end());
+    }
+
+    return BlockRange(columnBlocks.begin() + columnStarts[firstColumn], columnBlocks.begin() + columnStarts[lastColumn + 1]);
+}
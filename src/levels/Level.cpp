@@ -1,6 +1,44 @@
 #include "levels/Level.hpp"
+#include "Projectile.hpp"
 #include "gameDimensions.hpp"
 #include <cmath>
+#include <algorithm>
+#include <limits>
+
+// Index of the lowest set bit in a non-zero word
+static int lowestSetBit(uint64_t word) {
+#if defined(__GNUC__) || defined(__clang__)
+    return __builtin_ctzll(word);
+#else
+    int index = 0;
+    while (!(word & 1)) {
+        word >>= 1;
+        index++;
+    }
+    return index;
+#endif
+}
+
+// Mask of the bits in a word that fall between the bit indexes first and last (inclusive), relative to the word's start bit
+static uint64_t spanMask(int wordStart, int first, int last) {
+    int low = std::max(first - wordStart, 0);
+    int high = std::min(last - wordStart, 63);
+
+    uint64_t highMask = high == 63 ? ~0ULL : ((1ULL << (high + 1)) - 1);
+    return highMask & (~0ULL << low);
+}
+
+// Finds the first set bit between first and last (inclusive) in a packed bit array, or -1 if there is none
+static int firstSetBit(const uint64_t* words, int first, int last) {
+    for (int word = first / 64; word <= last / 64; word++) {
+        uint64_t bits = words[word] & spanMask(word * 64, first, last);
+
+        if (bits) {
+            return word * 64 + lowestSetBit(bits);
+        }
+    }
+    return -1;
+}
 
 
 // gets global ID for a given block
@@ -14,13 +52,9 @@ uint32_t Level::getID(const Vector2& block) const {
 }
 
 // gets the correct spritesheet given a specific global ID
-std::shared_ptr<Spritesheet> Level::getSpritesheetForGID(uint32_t gid) {
-    for (const auto& spritesheet : spritesheets) {
-        if (spritesheet->containsID(gid)) {
-            return spritesheet;
-        }
-    }
-    return nullptr; // No matching spritesheet found
+Spritesheet* Level::getSpritesheetForGID(uint32_t gid) const {
+    int index = getTileInfo(gid).spritesheet;
+    return index >= 0 ? spritesheets[index].get() : nullptr; // nullptr if no matching spritesheet was found
 }
 
 // loads map from tmx file, and populates spritesheets, blocks, and ids
@@ -39,6 +73,16 @@ bool Level::loadFromTMX(const std::string& filename, SDL_Renderer* renderer) {
     std::cout<<"dimensions "<<getDimensions()<<std::endl;
     // dimensions = Vector2(mapSize.x * tileSize.x, mapSize.y * tileSize.y);
     
+    // Size the GID table to fit every tileset
+    uint32_t lastGID = 0;
+
+    for (const auto& tileset : map.getTilesets()) {
+        lastGID = std::max(lastGID, tileset.getLastGID());
+    }
+
+    tileInfo.assign(lastGID + 1, TileInfo());
+    colliderTemplates.clear();
+
     //trying to grab the textures here using the Tileset.hpp from the tmxlite library
     for (const auto& tileset : map.getTilesets()) {
         std::string texturePath =  tileset.getImagePath();  
@@ -49,14 +93,27 @@ bool Level::loadFromTMX(const std::string& filename, SDL_Renderer* renderer) {
         std::shared_ptr<Spritesheet> spritesheet = std::make_shared<Spritesheet>(renderer, texturePath, Vector2(TILE_SIZE, TILE_SIZE), rows, columns);
         spritesheet->setGID(tileset.getFirstGID(),tileset.getLastGID());
         
+        int sheetIndex = spritesheets.size();
         spritesheets.emplace_back(spritesheet);
+        tileAtlas.add(*spritesheet, false);
+
+        for (uint32_t gid = tileset.getFirstGID(); gid <= tileset.getLastGID(); gid++) {
+            tileInfo[gid].spritesheet = sheetIndex;
+            tileInfo[gid].spriteIndex = gid - tileset.getFirstGID();
+        }
+
+        // Set up indexes of specific objects
+        if (tileset.getName() == "objects") {
+            tileInfo[tileset.getFirstGID()].flags |= TILE_HITBOX; // Collision tile
+        }
 
-        
         // Iterate over tiles in the tileset
         for (const auto& tile : tileset.getTiles()) {
             // Get the global tile ID by adding first GID
             unsigned int globalID = tileset.getFirstGID() + tile.ID;
-            
+            auto& info = tileInfo[globalID];
+            info.firstCollider = colliderTemplates.size();
+
             // Check if this tile has any collision objects
             for (const auto& object : tile.objectGroup.getObjects()) {
                     CollisionObject collObj;
@@ -68,22 +125,23 @@ bool Level::loadFromTMX(const std::string& filename, SDL_Renderer* renderer) {
                     collObj.bounds.h = static_cast<int>(object.getAABB().height);
                     collObj.type = object.getClass();
                     collObj.name = object.getName();
+
+                    if (collObj.type == "Obstacle") {
+                        collObj.flags |= COLLIDER_OBSTACLE;
+                    }
                     
                     // Add a locally based CollisionObject for a specific gid
-                    tileCollisions[globalID].push_back(collObj);
-    
+                    colliderTemplates.push_back(collObj);
+                    info.colliderCount++;
             }
-        
-            
-        
-        // Set up indexes of specific objects
-        if (tileset.getName() == "objects") {
-            auto first = tileset.getFirstGID();
 
-            hitboxIDs.emplace(first); // Collision tile
+            if (info.colliderCount > 0) {
+                info.flags |= TILE_COLLIDER;
+            }
         }
     }
-}
+
+    tileAtlas.build(renderer);
 
     for (const auto& layer : map.getLayers()) {
         blocks.clear();
@@ -174,15 +232,13 @@ bool Level::loadFromTMX(const std::string& filename, SDL_Renderer* renderer) {
             
                 if (tileID == 0) continue;
             
-                auto it = tileCollisions.find(tileID);
-                if (it != tileCollisions.end()) {
-            
-                    for (const auto& objTemplate : it->second) {
-                        CollisionObject worldObj = objTemplate;
-                        worldObj.bounds.x += x * TILE_SIZE;
-                        worldObj.bounds.y += y * TILE_SIZE;            
-                        collisionObjects.push_back(worldObj);
-                    }
+                auto& info = getTileInfo(tileID);
+
+                for (int collider = info.firstCollider; collider < info.firstCollider + info.colliderCount; collider++) {
+                    CollisionObject worldObj = colliderTemplates[collider];
+                    worldObj.bounds.x += x * TILE_SIZE;
+                    worldObj.bounds.y += y * TILE_SIZE;            
+                    collisionObjects.push_back(worldObj);
                 }
             
                 if (tile.ID > 0) {
@@ -202,252 +258,595 @@ bool Level::loadFromTMX(const std::string& filename, SDL_Renderer* renderer) {
         
     
     }
+
+    buildCollisionGrid(mapSize.x, mapSize.y);
+    buildMergedColliders();
+    buildSurfaceMap();
+    cullOverdraw();
+    tileChunks.bake(renderer, *this);
+    spatialHash.resize(getDimensions());
     return true;
 }
 
-bool Level::loadData(GameLogic& gameLogic, LevelData& levelData, SDL_Renderer* renderer) {
+double Level::groundBelow(double x, double y) const {
+    int column = static_cast<int>(floor(x / TILE_SIZE));
+
+    if (column < 0 || column >= gridColumns) {
+        return -1;
+    }
+
+    auto first = surfaceTops.begin() + surfaceStarts[column];
+    auto last = surfaceTops.begin() + surfaceStarts[column + 1];
+    auto surface = std::lower_bound(first, last, y);
+
+    return surface != last ? *surface : -1;
+}
+
+void Level::snapToGround(EntityStore& store, const BoundingBox& hitbox, double height) {
+    size_t index = store.size() - 1;
+    auto box = hitbox + store.getPosition(index);
+
+    // We only really care about the center x here
+    double ground = groundBelow((box.getLeftX() + box.getRightX()) / 2.0, box.getBottomY());
+
+    if (ground >= 0) {
+        store.setGroundLevel(index, ground - height / 2);
+    }
+}
+
+bool Level::loadData(LevelData& levelData, SDL_Renderer* renderer) {
     if (!loadFromTMX(levelData.getFilePath(), renderer)) {
         return false;
     }
 
     // Set up enemies
     enemies.clear();
-    // for (auto enemyData : levelEnemyData ) {
-    //     auto startPos = enemyData.getStartPos();
-    //     std::cout<<"startPoint"<< startPos<<std::endl;
-    // }
-    // for (auto enemyData : levelData.getEnemies()) {
+    corgis.clear();
+    powerups.clear();
+    projectiles.clear();
+
     for (auto enemyData : levelEnemyData) {
         auto startPos = enemyData.getStartPos();
 
         std::cout << enemyData.getStartPos() << ", " << enemyData.getTrackStart() << ", " << enemyData.getTrackEnd() << std::endl;
 
-        Enemy enemy(
-            gameLogic,
-            enemyData.getStartPos(),
-            enemyData.getTrackStart(),
-            enemyData.getTrackEnd(),
-            enemyData.getCanShoot(),
-            enemyData.getIsBiker()
-        );
-
-        // Find a solid object along that line
-        auto hitbox = enemy.getHitbox() + startPos;
-
-        auto leftX = hitbox.getLeftX();
-        auto rightX = hitbox.getRightX();
-        auto centerX = (leftX + rightX) / 2.0;
-        auto bottomY = hitbox.getBottomY();
-
-        double targetY = 768;
-
-        // We only really care about the center x here
-        for (auto y = bottomY; y <= WINDOW_HEIGHT; y += TILE_SIZE / 2) {
-            auto worldTile = getWorldCollisionObject(Vector2(floor(centerX / TILE_SIZE), floor(y / TILE_SIZE)));
-
-            if (worldTile) {
-                auto bounds = worldTile->bounds;
-                targetY = bounds.y - ENEMY_HEIGHT / 2;
-                enemy.setGroundLevel(targetY);
-                break;
-            }
+        uint8_t flags = ENTITY_PATROLLING;
+
+        if (enemyData.getCanShoot()) {
+            flags |= ENTITY_CAN_SHOOT;
         }
 
-        enemies.push_back(std::make_shared<Enemy>(enemy));
+        if (enemyData.getIsBiker()) {
+            flags |= ENTITY_BIKER;
+        }
+
+        enemies.add(startPos, enemyData.getTrackStart(), enemyData.getTrackEnd(), ENEMY_HITBOX, flags, rand() % 2 == 0 ? 0 : 2);
+        snapToGround(enemies, ENEMY_HITBOX, ENEMY_HEIGHT);
     }
 
     for (auto corgiDataItem : corgiData) {
         auto startPos = corgiDataItem.getStartPos();
 
-        Corgi corgi(
-            corgiDataItem.getStartPos(),
-            corgiDataItem.getTrackStart(),
-            corgiDataItem.getTrackEnd()
-        );
+        corgis.add(startPos, corgiDataItem.getTrackStart(), corgiDataItem.getTrackEnd(), CORGI_HITBOX, ENTITY_PATROLLING, rand() % 2 == 0 ? 0 : 2);
+        snapToGround(corgis, CORGI_HITBOX, 32);
+    }
 
-        // Find a solid object along that line
-        auto hitbox = corgi.getHitbox() + startPos;
 
-        auto leftX = hitbox.getLeftX();
-        auto rightX = hitbox.getRightX();
-        auto centerX = (leftX + rightX) / 2.0;
-        auto bottomY = hitbox.getBottomY();
+    for (auto powerupDataItem : powerupData) {
+        auto startPos = powerupDataItem.getStartPos();
 
-        double targetY = 768;
+        powerups.add(startPos, powerupDataItem.getTrackStart(), powerupDataItem.getTrackEnd(), POWERUP_HITBOX, 0);
+        snapToGround(powerups, POWERUP_HITBOX, 32);
+        std::cout<<"Adding powerup"<<std::endl;
+    }
 
-        // We only really care about the center x here
-        for (auto y = bottomY; y <= WINDOW_HEIGHT; y += TILE_SIZE / 2) {
-            auto worldTile = getWorldCollisionObject(Vector2(floor(centerX / TILE_SIZE), floor(y / TILE_SIZE)));
+    return true;
+}
 
-            if (worldTile) {
-                auto bounds = worldTile->bounds;
-                targetY = bounds.y - 32 / 2;
-                corgi.setGroundLevel(targetY);
-                break;
-            }
+const CollisionObject* Level::getLocalCollisionObject(const Vector2& position) const {
+    
+    for (const auto& layer : layers) {
+        uint32_t gid = layer->getID(position);  // Get the GID for the tile at the given position
+
+        if (isCollisionGID(gid)) {
+            auto& collider = colliderTemplates[getTileInfo(gid).firstCollider];
+
+            // if(position.get(X))
+            std::cout << "Collide with " << collider.name << std::endl;
+            return &collider;
         }
+    }
+    return nullptr;
+}
+
+const CollisionObject* Level::getWorldCollisionObject(const Vector2& position) const {
+    int tileX = static_cast<int>(floor(position.getX()));
+    int tileY = static_cast<int>(floor(position.getY()));
 
-        corgis.push_back(std::make_shared<Corgi>(corgi));
+    if (tileX < 0 || tileX >= gridColumns || tileY < 0 || tileY >= gridRows) {
+        return nullptr;
     }
 
+    return collisionGrid[tileY * gridColumns + tileX];
+}
 
-    for (auto powerupDataItem : powerupData) {
-        auto startPos = powerupDataItem.getStartPos();
+const CollisionObject* Level::getMergedCollisionObject(int column, int row) const {
+    if (column < 0 || column >= gridColumns || row < 0 || row >= gridRows) {
+        return nullptr;
+    }
 
-        Powerup powerup(
-            powerupDataItem.getStartPos(),
-            powerupDataItem.getTrackStart(),
-            powerupDataItem.getTrackEnd()
-        );
+    int merged = mergedGrid[row * gridColumns + column];
+    return merged != -1 ? &mergedColliders[merged] : nullptr;
+}
 
-        // Find a solid object along that line
-        auto hitbox = powerup.getHitbox() + startPos;
+bool Level::colliderTileAt(const Vector2& position) const {
+    return getWorldCollisionObject(position) != nullptr;
+}
 
-        auto leftX = hitbox.getLeftX();
-        auto rightX = hitbox.getRightX();
-        auto centerX = (leftX + rightX) / 2.0;
-        auto bottomY = hitbox.getBottomY();
+int Level::firstSolidColumn(int row, int colStart, int colEnd) const {
+    colStart = std::max(colStart, 0);
+    colEnd = std::min(colEnd, gridColumns - 1);
 
-        double targetY = 768;
+    if (row < 0 || row >= gridRows || colStart > colEnd) {
+        return -1;
+    }
 
-        // We only really care about the center x here
-        for (auto y = bottomY; y <= WINDOW_HEIGHT; y += TILE_SIZE / 2) {
-            auto worldTile = getWorldCollisionObject(Vector2(floor(centerX / TILE_SIZE), floor(y / TILE_SIZE)));
+    return firstSetBit(&solidRows[row * wordsPerRow], colStart, colEnd);
+}
 
-            if (worldTile) {
-                auto bounds = worldTile->bounds;
-                targetY = bounds.y - 32 / 2;
-                powerup.setGroundLevel(targetY);
-                break;
-            }
+// Sweeps box along displacement against a single collider (swept AABB), updating result if it is hit sooner
+static void sweepAgainst(const BoundingBox& box, const Vector2& displacement, const CollisionObject& object, SweepResult& result) {
+    const double infinity = std::numeric_limits<double>::infinity();
+
+    double dx = displacement.getX();
+    double dy = displacement.getY();
+
+    double left = object.bounds.x;
+    double right = object.bounds.x + object.bounds.w;
+    double top = object.bounds.y;
+    double bottom = object.bounds.y + object.bounds.h;
+
+    bool overlapsX = box.getRightX() > left && box.getLeftX() < right;
+    bool overlapsY = box.getBottomY() > top && box.getTopY() < bottom;
+
+    if (overlapsX && overlapsY) {
+        // Already inside: only stop the box if it is moving deeper, along the axis with the smallest penetration
+        double centerX = (box.getLeftX() + box.getRightX()) / 2;
+        double centerY = (box.getTopY() + box.getBottomY()) / 2;
+        double penetration = infinity;
+        Vector2 normal;
+
+        if (dx > 0 && centerX < (left + right) / 2) {
+            penetration = box.getRightX() - left;
+            normal = Vector2(-1, 0);
+        } else if (dx < 0 && centerX > (left + right) / 2) {
+            penetration = right - box.getLeftX();
+            normal = Vector2(1, 0);
+        }
+
+        if (dy > 0 && centerY < (top + bottom) / 2 && box.getBottomY() - top < penetration) {
+            normal = Vector2(0, -1);
+        } else if (dy < 0 && centerY > (top + bottom) / 2 && bottom - box.getTopY() < penetration) {
+            normal = Vector2(0, 1);
         }
-        std::cout<<"Adding powerup"<<std::endl;
 
-        powerups.push_back(std::make_shared<Powerup>(powerup));
+        if ((normal.getX() != 0 || normal.getY() != 0) && !(result.hit && result.time <= 0)) {
+            result.hit = true;
+            result.time = 0;
+            result.normal = normal;
+            result.object = &object;
+        }
+        return;
     }
 
-    return true;
+    // Times at which the box starts and stops overlapping on each axis
+    double entryX, exitX, entryY, exitY;
+
+    if (dx > 0) {
+        entryX = (left - box.getRightX()) / dx;
+        exitX = (right - box.getLeftX()) / dx;
+    } else if (dx < 0) {
+        entryX = (right - box.getLeftX()) / dx;
+        exitX = (left - box.getRightX()) / dx;
+    } else if (overlapsX) {
+        entryX = -infinity;
+        exitX = infinity;
+    } else {
+        return;
+    }
+
+    if (dy > 0) {
+        entryY = (top - box.getBottomY()) / dy;
+        exitY = (bottom - box.getTopY()) / dy;
+    } else if (dy < 0) {
+        entryY = (bottom - box.getTopY()) / dy;
+        exitY = (top - box.getBottomY()) / dy;
+    } else if (overlapsY) {
+        entryY = -infinity;
+        exitY = infinity;
+    } else {
+        return;
+    }
+
+    double entry = std::max(entryX, entryY);
+    double exit = std::min(exitX, exitY);
+
+    // Only grazing the collider (or missing it entirely) does not count as a hit
+    if (entry >= exit || entry < 0 || entry > 1 || (result.hit && entry >= result.time)) {
+        return;
+    }
+
+    result.hit = true;
+    result.time = entry;
+    result.object = &object;
+
+    if (entryX > entryY) {
+        result.normal = Vector2(dx > 0 ? -1 : 1, 0);
+    } else {
+        result.normal = Vector2(0, dy > 0 ? -1 : 1);
+    }
 }
 
-const CollisionObject* Level::getLocalCollisionObject(const Vector2& position) const {
-    
-    for (const auto& layer : layers) {
-        uint32_t gid = layer->getID(position);  // Get the GID for the tile at the given position
+SweepResult Level::sweepBox(const BoundingBox& box, const Vector2& displacement) const {
+    SweepResult result;
 
-        if (isCollisionGID(gid)) {
+    // Every tile the box could touch along the way
+    auto moved = box + displacement;
+    int firstColumn = static_cast<int>(floor(std::min(box.getLeftX(), moved.getLeftX()) / TILE_SIZE));
+    int lastColumn = static_cast<int>(floor(std::max(box.getRightX(), moved.getRightX()) / TILE_SIZE));
+    int firstRow = static_cast<int>(floor(std::min(box.getTopY(), moved.getTopY()) / TILE_SIZE));
+    int lastRow = static_cast<int>(floor(std::max(box.getBottomY(), moved.getBottomY()) / TILE_SIZE));
+
+    firstRow = std::max(firstRow, 0);
+    lastRow = std::min(lastRow, gridRows - 1);
 
-            auto it = tileCollisions.find(gid);
-            if (it != tileCollisions.end() && !it->second.empty()) {
-                
-                // if(position.get(X))
-                std::cout << "Collide with " << it->second[0].name << std::endl;
-                return &it->second[0];  
+    // Test each merged collider once, no matter how many of its tiles the box passes over
+    sweptColliders.clear();
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstSolidColumn(row, firstColumn, lastColumn); column != -1; column = firstSolidColumn(row, column + 1, lastColumn)) {
+            int merged = mergedGrid[row * gridColumns + column];
+
+            if (std::find(sweptColliders.begin(), sweptColliders.end(), merged) != sweptColliders.end()) {
+                continue;
             }
+
+            sweptColliders.push_back(merged);
+            sweepAgainst(box, displacement, mergedColliders[merged], result);
         }
     }
-    return nullptr;
+
+    return result;
 }
 
-const CollisionObject* Level::getWorldCollisionObject(const Vector2& position) const {
-    
-    for (const auto layer : layers) {
-        uint32_t gid = layer->getID(position);
-        if (isCollisionGID(gid)) {
+RaycastHit Level::raycast(const Vector2& origin, const Vector2& direction, double maxDistance) const {
+    const double infinity = std::numeric_limits<double>::infinity();
+    RaycastHit result;
 
-            // Calculate the tile's grid position
-            int tileX = static_cast<int>(position.getX() );
-            int tileY = static_cast<int>(position.getY() );
-        
-            // Find the actual collision object in the world
-            for (const auto& obj : collisionObjects) {
-                // Calculate the tile position from the object's position
-                int objTileX = obj.bounds.x / TILE_SIZE;
-                int objTileY = obj.bounds.y / TILE_SIZE;
-                
-                // Check if this object is at the same tile position
-                if (objTileX == tileX && objTileY == tileY) {
-                              return &obj;
-                              
+    auto unit = direction.normal();
+    double dx = unit.getX();
+    double dy = unit.getY();
+
+    if ((dx == 0 && dy == 0) || maxDistance <= 0) {
+        return result;
+    }
+
+    int column = static_cast<int>(floor(origin.getX() / TILE_SIZE));
+    int row = static_cast<int>(floor(origin.getY() / TILE_SIZE));
+    int stepX = dx > 0 ? 1 : (dx < 0 ? -1 : 0);
+    int stepY = dy > 0 ? 1 : (dy < 0 ? -1 : 0);
+
+    // Distance along the ray to the next column/row boundary, and between boundaries
+    double nextX = dx > 0 ? ((column + 1) * TILE_SIZE - origin.getX()) / dx : (dx < 0 ? (column * TILE_SIZE - origin.getX()) / dx : infinity);
+    double nextY = dy > 0 ? ((row + 1) * TILE_SIZE - origin.getY()) / dy : (dy < 0 ? (row * TILE_SIZE - origin.getY()) / dy : infinity);
+    double deltaX = dx != 0 ? TILE_SIZE / std::abs(dx) : infinity;
+    double deltaY = dy != 0 ? TILE_SIZE / std::abs(dy) : infinity;
+
+    // A point with no size sweeping along the whole ray, so the swept AABB test gives the exact hit
+    auto point = BoundingBox(origin, Vector2(0, 0));
+    auto displacement = unit * maxDistance;
+    SweepResult sweep;
+    double distance = 0;
+
+    while (distance <= maxDistance) {
+        if (column >= 0 && column < gridColumns && row >= 0 && row < gridRows) {
+            auto object = collisionGrid[row * gridColumns + column];
+
+            if (object) {
+                auto& bounds = object->bounds;
+                bool inside = origin.getX() > bounds.x && origin.getX() < bounds.x + bounds.w && origin.getY() > bounds.y && origin.getY() < bounds.y + bounds.h;
+
+                if (inside) {
+                    sweep.hit = true;
+                    sweep.time = 0;
+                    sweep.normal = Vector2();
+                    sweep.object = object;
+                } else {
+                    sweepAgainst(point, displacement, *object, sweep);
+                }
+
+                // Colliders stay inside their tile, so the first tile with a hit has the closest one
+                if (sweep.hit) {
+                    result.hit = true;
+                    result.distance = sweep.time * maxDistance;
+                    result.point = origin + unit * result.distance;
+                    result.column = column;
+                    result.row = row;
+                    result.normal = sweep.normal;
+                    result.object = sweep.object;
+                    return result;
                 }
             }
-            
-            
+        }
+
+        // Nothing can be hit once the ray leaves the grid for good
+        if ((column < 0 && stepX <= 0) || (column >= gridColumns && stepX >= 0) || (row < 0 && stepY <= 0) || (row >= gridRows && stepY >= 0)) {
+            break;
+        }
+
+        // Step into whichever neighbouring tile the ray reaches first
+        if (nextX < nextY) {
+            distance = nextX;
+            nextX += deltaX;
+            column += stepX;
+        } else {
+            distance = nextY;
+            nextY += deltaY;
+            row += stepY;
         }
     }
-    return nullptr;
+
+    return result;
 }
 
-bool Level::colliderTileAt(const Vector2& position) const {
+RaycastHit Level::castSegment(const Vector2& from, const Vector2& to) const {
+    auto difference = to - from;
+    return raycast(from, difference, difference.magnitude());
+}
 
-    for (const auto layer : layers) {
-        uint32_t gid = layer->getID(position);
-        if (isCollisionGID(gid)) {
-            // Calculate the tile's grid position
-            int tileX = static_cast<int>(position.getX() );
-            int tileY = static_cast<int>(position.getY() );
-           
-            // Find the actual collision object in the world
-            for (const auto& obj : collisionObjects) {
-                // Calculate the tile position from the object's position
-                int objTileX = obj.bounds.x / TILE_SIZE;
-                int objTileY = obj.bounds.y / TILE_SIZE;
-                // std::cout<<"collide X: "<<objTileX<<"collide Y" <<objTileY<<std::endl;
-                
-                // Check if this object is at the same tile position
-                if (objTileX == tileX && objTileY == tileY) {
-                   
-               return true; }
-            }
-            
-            
+bool Level::damageEnemyAt(const BoundingBox& box) {
+    spatialHash.query(box, SPATIAL_ENEMY, nearbyEntries);
+
+    for (auto entry : nearbyEntries) {
+        auto enemy = getEnemy(entry->index);
+
+        if (box.overlaps(enemy.getHitbox() + enemy.getPosition())) {
+            enemy.decrementHealth();
+            return true;
         }
     }
+
     return false;
 }
 
-void Level::removeDeadEnemies() {
-    // Move the projectiles, while marking any which should be deleted
-    std::vector<size_t> toDelete;
+void Level::buildCollisionGrid(int columns, int rows) {
+    gridColumns = columns;
+    gridRows = rows;
+    collisionGrid.assign(columns * rows, nullptr);
 
-    for (size_t idx = 0; idx < enemies.size(); idx++) {
-        auto enemy = enemies[idx];
+    wordsPerRow = (columns + 63) / 64;
+    solidRows.assign(rows * wordsPerRow, 0);
+
+    // Objects were added layer by layer, so the first object found for a tile is the one that should be returned
+    for (const auto& obj : collisionObjects) {
+        int tileX = obj.bounds.x / TILE_SIZE;
+        int tileY = obj.bounds.y / TILE_SIZE;
+
+        if (tileX < 0 || tileX >= columns || tileY < 0 || tileY >= rows) {
+            continue;
+        }
+
+        auto& cell = collisionGrid[tileY * columns + tileX];
+
+        if (!cell) {
+            cell = &obj;
+
+            solidRows[tileY * wordsPerRow + tileX / 64] |= 1ULL << (tileX % 64);
+        }
+    }
+}
+
+// Does the collider fill the whole tile at the given column and row
+static bool isFullTile(const CollisionObject& object, int column, int row) {
+    return object.bounds.x == column * TILE_SIZE && object.bounds.y == row * TILE_SIZE && object.bounds.w == TILE_SIZE && object.bounds.h == TILE_SIZE;
+}
+
+void Level::buildMergedColliders() {
+    mergedColliders.clear();
+    mergedGrid.assign(gridColumns * gridRows, -1);
+
+    for (int row = 0; row < gridRows; row++) {
+        for (int column = 0; column < gridColumns; column++) {
+            auto object = collisionGrid[row * gridColumns + column];
+
+            if (!object || mergedGrid[row * gridColumns + column] != -1) {
+                continue;
+            }
+
+            // Can the tile join a rectangle started by object (same kind of full-tile collider, not already merged)
+            auto canMerge = [&](int otherColumn, int otherRow) {
+                auto other = collisionGrid[otherRow * gridColumns + otherColumn];
+
+                return other && mergedGrid[otherRow * gridColumns + otherColumn] == -1 && isFullTile(*other, otherColumn, otherRow)
+                    && other->type == object->type && other->name == object->name;
+            };
+
+            CollisionObject merged = *object;
+            int width = 1;
+            int height = 1;
+
+            if (isFullTile(*object, column, row)) {
+                // Grow right as far as possible, then down while the whole run below matches
+                while (column + width < gridColumns && canMerge(column + width, row)) {
+                    width++;
+                }
+
+                bool rowMatches = true;
+
+                while (rowMatches && row + height < gridRows) {
+                    for (int x = column; x < column + width && rowMatches; x++) {
+                        rowMatches = canMerge(x, row + height);
+                    }
+
+                    if (rowMatches) {
+                        height++;
+                    }
+                }
 
-        if (!enemy->isAlive()) {
-            toDelete.push_back(idx);
+                merged.bounds.w = width * TILE_SIZE;
+                merged.bounds.h = height * TILE_SIZE;
+            }
+
+            int index = mergedColliders.size();
+            mergedColliders.push_back(merged);
+
+            for (int y = row; y < row + height; y++) {
+                for (int x = column; x < column + width; x++) {
+                    mergedGrid[y * gridColumns + x] = index;
+                }
+            }
         }
     }
+}
+
+void Level::buildSurfaceMap() {
+    surfaceStarts.assign(gridColumns + 1, 0);
+    surfaceTops.clear();
 
-    // Delete the corresponding indexes
-    if (toDelete.size() > 0) {
-        // This is needed to keep the indexes accurate
-        int deleted = 0;
+    for (int column = 0; column < gridColumns; column++) {
+        surfaceStarts[column] = surfaceTops.size();
 
-        for (auto idx : toDelete) {
-            enemies.erase(enemies.begin() + idx - deleted);
-            deleted++;
+        for (int row = 0; row < gridRows; row++) {
+            auto object = collisionGrid[row * gridColumns + column];
+
+            // Only the top of a stack of colliders can be stood on
+            if (object && (row == 0 || !collisionGrid[(row - 1) * gridColumns + column])) {
+                surfaceTops.push_back(object->bounds.y);
+            }
         }
     }
+
+    surfaceStarts[gridColumns] = surfaceTops.size();
 }
 
-void Level::removeCollectedPowerups() {
-    std::vector<size_t> toDelete;
+const FrameCoverage* Level::getTileCoverage(uint32_t gid) const {
+    auto spritesheet = getSpritesheetForGID(gid);
+    return spritesheet ? spritesheet->getCoverage(getTileInfo(gid).spriteIndex) : nullptr;
+}
 
-    for (size_t idx = 0; idx < powerups.size(); idx++) {
-        auto powerup = powerups[idx];
-        if (!powerup->isActive()) {
-        toDelete.push_back(idx);
+void Level::cullOverdraw() {
+    // Cells covered by an opaque tile of a layer above the current one
+    std::vector<bool> covered(gridColumns * gridRows, false);
+
+    for (size_t layerIndex = layers.size(); layerIndex-- > 0;) {
+        auto& layer = layers[layerIndex];
+        auto& blocks = layer->getBlocks();
+
+        // Layers that are faded differently are drawn separately, so a tile only hides the ones under it in the same run of
+        // equally faded layers (and only if that run isn't faded at all)
+        if (layerIndex + 1 < layers.size() && layers[layerIndex + 1]->getOpacity() != layer->getOpacity()) {
+            covered.assign(covered.size(), false);
+        }
+
+        bool opaqueLayer = layer->getOpacity() == 1.0f;
+
+        std::vector<bool> hidden(blocks.size(), false);
+        std::vector<bool> coveredHere(covered.size(), false);
+
+        // A layer with the same solid tile in every cell can be drawn as one fill
+        uint32_t fillGID = blocks.size() == covered.size() && !blocks.empty() ? layer->getID(0) : 0;
+
+        for (size_t i = 0; i < blocks.size(); i++) {
+            auto& block = std::get<0>(blocks[i]);
+            int column = block.getX();
+            int row = block.getY();
+            uint32_t gid = layer->getID(i);
+
+            if (gid != fillGID) {
+                fillGID = 0;
+            }
+
+            // Hitbox tiles can be toggled on and off, so they neither hide nor get hidden
+            if (getTileInfo(gid).flags & TILE_HITBOX) {
+                continue;
+            }
+
+            auto coverage = getTileCoverage(gid);
+
+            if (coverage == nullptr || column < 0 || column >= gridColumns || row < 0 || row >= gridRows) {
+                continue;
+            }
+
+            int cell = row * gridColumns + column;
+            hidden[i] = coverage->empty || covered[cell];
+
+            if (opaqueLayer && coverage->opaque) {
+                coveredHere[cell] = true;
+            }
+        }
+
+        auto fillCoverage = fillGID ? getTileCoverage(fillGID) : nullptr;
+
+        if (fillCoverage && fillCoverage->solid && fillCoverage->opaque && !(getTileInfo(fillGID).flags & TILE_HITBOX)) {
+            layer->setFill(fillCoverage->color);
+        } else {
+            layer->hideBlocks(hidden);
+        }
+
+        for (size_t cell = 0; cell < covered.size(); cell++) {
+            covered[cell] = covered[cell] || coveredHere[cell];
         }
     }
+}
 
-    // Delete the corresponding indexes
-    if (toDelete.size() > 0) {
-        // This is needed to keep the indexes accurate
-        int deleted = 0;
+void Level::updateActivity(double windowStart, double windowEnd, double ms) {
+    enemies.updateActivity(windowStart, windowEnd, ms);
+    corgis.updateActivity(windowStart, windowEnd, ms);
+    powerups.updateActivity(windowStart, windowEnd, ms);
+}
+
+void Level::updateSpatialHash() {
+    spatialHash.clear();
 
-        for (auto idx : toDelete) {
-            powerups.erase(powerups.begin() + idx - deleted);
-            deleted++;
+    for (size_t idx = 0; idx < enemies.size(); idx++) {
+        if (enemies.hasFlag(idx, ENTITY_ASLEEP)) {
+            continue;
         }
+
+        auto enemy = getEnemy(idx);
+        spatialHash.insert(enemy.getHitbox() + enemy.getPosition(), SPATIAL_ENEMY, idx);
     }
-    
-}
\ No newline at end of file
+
+    for (size_t idx = 0; idx < corgis.size(); idx++) {
+        if (corgis.hasFlag(idx, ENTITY_ASLEEP)) {
+            continue;
+        }
+
+        auto corgi = getCorgi(idx);
+        spatialHash.insert(corgi.getHitbox() + corgi.getPosition(), SPATIAL_CORGI, idx);
+    }
+
+    for (size_t idx = 0; idx < powerups.size(); idx++) {
+        if (powerups.hasFlag(idx, ENTITY_ASLEEP)) {
+            continue;
+        }
+
+        auto powerup = getPowerup(idx);
+        spatialHash.insert(powerup.getHitbox() + powerup.getPosition(), SPATIAL_POWERUP, idx);
+    }
+
+    for (size_t idx = 0; idx < projectiles.size(); idx++) {
+        auto& projectile = projectiles[idx];
+        auto kind = projectile.getOwner() == ProjectileOwner::PLAYER ? SPATIAL_PLAYER_PROJECTILE : SPATIAL_ENEMY_PROJECTILE;
+        spatialHash.insert(projectile.getHitbox() + projectile.getPosition(), kind, idx);
+    }
+
+    spatialHash.build();
+}
+
+void Level::removeFinishedEntities() {
+    enemies.compact();
+    corgis.compact();
+    powerups.compact();
+    projectiles.compact();
+}
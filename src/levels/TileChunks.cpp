@@ -0,0 +1,190 @@
+#include "levels/TileChunks.hpp"
+#include "levels/Level.hpp"
+#include "gameDimensions.hpp"
+#include "TextureResidency.hpp"
+
+#include <iostream>
+#include <cmath>
+#include <algorithm>
+
+void TileChunks::drawLayerChunk(size_t layerIndex, int chunk, SDL_BlendMode blendMode) {
+    auto& layer = level->getLayers()[layerIndex];
+    auto& blocks = layer->getBlocks();
+
+    if (layer->hasFill()) {
+        auto color = layer->getFillColor();
+        auto chunkArea = SDL_Rect { 0, 0, CHUNK_WIDTH, height };
+
+        SDL_BlendMode previousBlendMode;
+        SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+
+        // A solid layer covers the whole chunk, so it's one fill rather than a copy per tile
+        SDL_SetRenderDrawBlendMode(renderer, blendMode);
+        SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+        SDL_RenderFillRect(renderer, &chunkArea);
+        SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+    }
+
+    int firstColumn = chunk * CHUNK_WIDTH / TILE_SIZE;
+    int lastColumn = (chunk + 1) * CHUNK_WIDTH / TILE_SIZE - 1;
+
+    auto range = layer->getBlocksInColumns(firstColumn, lastColumn);
+
+    for (auto it = range.first; it != range.second; it++) {
+        int i = *it;
+        auto& block = std::get<0>(blocks[i]);
+        auto flip = std::get<1>(blocks[i]);
+        uint32_t tileID = layer->getID(i);
+
+        auto& info = level->getTileInfo(tileID);
+
+        if ((info.flags & TILE_HITBOX) || info.spritesheet < 0) {
+            continue;
+        }
+
+        auto& spritesheet = level->getSpritesheets()[info.spritesheet];
+
+        auto drawOffset = TILE_SIZE / 2;
+        Vector2 blockPosition(block.getX() * TILE_SIZE - chunk * CHUNK_WIDTH + drawOffset, block.getY() * TILE_SIZE + drawOffset);
+
+        spritesheet->setBlendMode(blendMode);
+        spritesheet->draw(info.spriteIndex, blockPosition, flip, 1.0);
+    }
+}
+
+bool TileChunks::renderChunk(size_t groupIndex, int chunk) {
+    auto& group = groups[groupIndex];
+
+    auto previousTarget = SDL_GetRenderTarget(renderer);
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+
+    auto texture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, CHUNK_WIDTH, height);
+
+    if (texture == NULL || SDL_SetRenderTarget(renderer, texture) != 0) {
+        if (texture != NULL) {
+            SDL_DestroyTexture(texture);
+        }
+
+        SDL_SetRenderTarget(renderer, previousTarget);
+        return false;
+    }
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+    SDL_RenderClear(renderer);
+
+    // The bottom layer is copied as is, so its pixels keep their exact colour and alpha
+    for (size_t layer = group.firstLayer; layer <= group.lastLayer; layer++) {
+        drawLayerChunk(layer, chunk, layer == group.firstLayer ? SDL_BLENDMODE_NONE : SDL_BLENDMODE_BLEND);
+    }
+
+    for (auto& spritesheet : level->getSpritesheets()) {
+        spritesheet->setBlendMode(SDL_BLENDMODE_BLEND);
+    }
+
+    SDL_SetRenderTarget(renderer, previousTarget);
+    SDL_SetRenderDrawColor(renderer, r, g, b, a);
+
+    group.chunks[chunk] = texture;
+
+    // Chunks can always be rendered again from the level, so any that are off screen can be freed
+    TextureResidency::getInstance()->add(texture, (size_t) CHUNK_WIDTH * height * 4, [this, groupIndex, chunk]() {
+        auto& slot = groups[groupIndex].chunks[chunk];
+        SDL_DestroyTexture(slot);
+        slot = nullptr;
+        return true;
+    });
+
+    return true;
+}
+
+bool TileChunks::bake(SDL_Renderer* _renderer, Level& _level) {
+    destroy();
+    renderer = _renderer;
+    level = &_level;
+
+    if (!SDL_RenderTargetSupported(renderer)) {
+        // Not fatal (unlike sdlError), the level can still be drawn tile by tile
+        std::cerr << "Renderer can't render to textures, drawing tiles one at a time instead" << std::endl;
+        return false;
+    }
+
+    auto& layers = level->getLayers();
+    int width = static_cast<int>(level->getDimensions().getX());
+    int chunkCount = (width + CHUNK_WIDTH - 1) / CHUNK_WIDTH;
+    height = static_cast<int>(level->getDimensions().getY());
+
+    size_t first = 0;
+
+    while (first < layers.size()) {
+        // Layers can only share chunks if they are faded the same amount
+        size_t last = first;
+
+        while (last + 1 < layers.size() && layers[last + 1]->getOpacity() == layers[first]->getOpacity()) {
+            last++;
+        }
+
+        groups.emplace_back();
+        auto& group = groups.back();
+        group.opacity = layers[first]->getOpacity();
+        group.firstLayer = first;
+        group.lastLayer = last;
+        group.chunks.assign(chunkCount, nullptr);
+
+        first = last + 1;
+    }
+
+    baked = true;
+    return true;
+}
+
+void TileChunks::draw(double scrollOffset, double alpha) {
+    int firstChunk = std::max(static_cast<int>(floor(scrollOffset / CHUNK_WIDTH)), 0);
+    int lastChunk = static_cast<int>(floor((scrollOffset + WINDOW_WIDTH) / CHUNK_WIDTH));
+
+    for (size_t groupIndex = 0; groupIndex < groups.size(); groupIndex++) {
+        auto& group = groups[groupIndex];
+        int end = std::min(lastChunk, static_cast<int>(group.chunks.size()) - 1);
+
+        for (int chunk = firstChunk; chunk <= end; chunk++) {
+            if (group.chunks[chunk] == nullptr && !renderChunk(groupIndex, chunk)) {
+                // Not fatal (unlike sdlError), the level can still be drawn tile by tile
+                std::cerr << "Could not create level chunk, drawing tiles one at a time instead: " << SDL_GetError() << std::endl;
+                destroy();
+                return;
+            }
+
+            auto texture = group.chunks[chunk];
+            auto drawPosition = SDL_Rect {
+                (int) (chunk * CHUNK_WIDTH - scrollOffset),
+                0,
+                CHUNK_WIDTH,
+                height
+            };
+
+            TextureResidency::getInstance()->touch(texture);
+            SDL_SetTextureAlphaMod(texture, group.opacity * alpha * 255);
+            SDL_RenderCopy(renderer, texture, NULL, &drawPosition);
+        }
+    }
+}
+
+void TileChunks::destroy() {
+    for (auto& group : groups) {
+        for (auto texture : group.chunks) {
+            if (texture != nullptr) {
+                TextureResidency::getInstance()->remove(texture);
+                SDL_DestroyTexture(texture);
+            }
+        }
+    }
+
+    groups.clear();
+    baked = false;
+}
+
+TileChunks::~TileChunks() {
+    destroy();
+}
@@ -20,4 +20,8 @@ namespace mathutils {
     double floorInterval(double num, double interval) {
         return floor(num / interval) * interval;
     }
+
+    Vector2 lerp(const Vector2& from, const Vector2& to, double t) {
+        return from + (to - from) * t;
+    }
 }
\ No newline at end of file
@@ -0,0 +1,96 @@
+#include "physics/SpatialHash.hpp"
+#include "mathutils.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+void SpatialHash::resize(const Vector2& worldSize) {
+    columns = std::max(1, (int) ceil(worldSize.getX() / SPATIAL_CELL_SIZE));
+    rows = std::max(1, (int) ceil(worldSize.getY() / SPATIAL_CELL_SIZE));
+    clear();
+}
+
+void SpatialHash::clear() {
+    entries.clear();
+    cellEntries.clear();
+    cellStarts.assign(columns * rows + 1, 0);
+}
+
+void SpatialHash::insert(const BoundingBox& bounds, SpatialKind kind, size_t index) {
+    entries.push_back(SpatialEntry { bounds, kind, index });
+}
+
+void SpatialHash::getCellRange(const BoundingBox& box, int& firstColumn, int& lastColumn, int& firstRow, int& lastRow) const {
+    firstColumn = (int) mathutils::clamp(floor(box.getLeftX() / SPATIAL_CELL_SIZE), 0, columns - 1);
+    lastColumn = (int) mathutils::clamp(floor(box.getRightX() / SPATIAL_CELL_SIZE), 0, columns - 1);
+    firstRow = (int) mathutils::clamp(floor(box.getTopY() / SPATIAL_CELL_SIZE), 0, rows - 1);
+    lastRow = (int) mathutils::clamp(floor(box.getBottomY() / SPATIAL_CELL_SIZE), 0, rows - 1);
+}
+
+void SpatialHash::build() {
+    // Counting sort: count the entries per cell, turn the counts into offsets, then place each entry
+    std::fill(cellStarts.begin(), cellStarts.end(), 0);
+
+    int firstColumn, lastColumn, firstRow, lastRow;
+
+    for (const auto& entry : entries) {
+        getCellRange(entry.bounds, firstColumn, lastColumn, firstRow, lastRow);
+
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                cellStarts[row * columns + column + 1]++;
+            }
+        }
+    }
+
+    for (size_t cell = 1; cell < cellStarts.size(); cell++) {
+        cellStarts[cell] += cellStarts[cell - 1];
+    }
+
+    cellEntries.resize(cellStarts.back());
+
+    // Each cell's write position starts at its offset
+    writePositions.assign(cellStarts.begin(), cellStarts.end() - 1);
+
+    for (unsigned int idx = 0; idx < entries.size(); idx++) {
+        getCellRange(entries[idx].bounds, firstColumn, lastColumn, firstRow, lastRow);
+
+        for (int row = firstRow; row <= lastRow; row++) {
+            for (int column = firstColumn; column <= lastColumn; column++) {
+                cellEntries[writePositions[row * columns + column]++] = idx;
+            }
+        }
+    }
+
+    // Reset the marks for querying
+    queryMarks.assign(entries.size(), 0);
+    queryStamp = 0;
+}
+
+void SpatialHash::query(const BoundingBox& box, unsigned int kinds, std::vector<const SpatialEntry*>& results) {
+    results.clear();
+    queryStamp++;
+
+    int firstColumn, lastColumn, firstRow, lastRow;
+    getCellRange(box, firstColumn, lastColumn, firstRow, lastRow);
+
+    for (int row = firstRow; row <= lastRow; row++) {
+        for (int column = firstColumn; column <= lastColumn; column++) {
+            int cell = row * columns + column;
+
+            for (auto pos = cellStarts[cell]; pos < cellStarts[cell + 1]; pos++) {
+                auto idx = cellEntries[pos];
+
+                if (queryMarks[idx] == queryStamp || !(entries[idx].kind & kinds)) {
+                    continue;
+                }
+
+                queryMarks[idx] = queryStamp;
+                results.push_back(&entries[idx]);
+            }
+        }
+    }
+
+    // Keep the results in insertion order so collisions resolve the same way as a linear scan would
+    std::sort(results.begin(), results.end());
+}
@@ -0,0 +1,133 @@
+#include "sprites/RenderQueue.hpp"
+
+#include <iostream>
+#include <utility>
+
+const RenderQueue::TextureInfo& RenderQueue::getTextureInfo(SDL_Texture* texture) {
+    auto found = textures.find(texture);
+
+    if (found != textures.end()) {
+        return found->second;
+    }
+
+    TextureInfo info;
+    info.id = textures.size();
+    SDL_QueryTexture(texture, NULL, NULL, &info.width, &info.height);
+
+    return textures.emplace(texture, info).first->second;
+}
+
+void RenderQueue::push(SDL_Texture* texture, const SDL_Rect& source, const SDL_Rect& destination, unsigned int depth, Uint8 alpha, bool flipped) {
+    if (texture == nullptr) {
+        return;
+    }
+
+    auto id = getTextureInfo(texture).id;
+
+    DrawCommand command;
+    command.key = ((uint64_t) (depth & 0xFFFF) << 24) | (id & 0xFFFFFF);
+    command.texture = texture;
+    command.source = source;
+    command.destination = destination;
+    command.alpha = alpha;
+    command.flipped = flipped;
+
+    commands.push_back(command);
+}
+
+void RenderQueue::radixSort() {
+    sorted.resize(commands.size());
+
+    // The key only uses its low 40 bits
+    for (int shift = 0; shift < 40; shift += 8) {
+        size_t counts[257] = {0};
+
+        for (const auto& command : commands) {
+            counts[((command.key >> shift) & 0xFF) + 1]++;
+        }
+
+        // Every key has the same byte here, so this pass wouldn't move anything
+        if (counts[((commands[0].key >> shift) & 0xFF) + 1] == commands.size()) {
+            continue;
+        }
+
+        for (int byte = 0; byte < 256; byte++) {
+            counts[byte + 1] += counts[byte];
+        }
+
+        for (const auto& command : commands) {
+            sorted[counts[(command.key >> shift) & 0xFF]++] = command;
+        }
+
+        commands.swap(sorted);
+    }
+}
+
+void RenderQueue::submitBatch(SDL_Texture* texture) {
+    if (indices.empty()) {
+        return;
+    }
+
+    // The alpha of each sprite is in its vertex colours
+    SDL_SetTextureAlphaMod(texture, 255);
+
+    if (SDL_RenderGeometry(renderer, texture, vertices.data(), vertices.size(), indices.data(), indices.size()) != 0) {
+        std::cerr << "Could not draw sprite batch: " << SDL_GetError() << std::endl;
+    }
+
+    vertices.clear();
+    indices.clear();
+}
+
+void RenderQueue::flush() {
+    if (commands.empty()) {
+        return;
+    }
+
+    radixSort();
+
+    SDL_Texture* batchTexture = nullptr;
+
+    for (const auto& command : commands) {
+        if (command.texture != batchTexture) {
+            submitBatch(batchTexture);
+            batchTexture = command.texture;
+        }
+
+        auto& info = getTextureInfo(command.texture);
+        auto& source = command.source;
+        auto& destination = command.destination;
+
+        float left = (float) source.x / info.width;
+        float right = (float) (source.x + source.w) / info.width;
+        float top = (float) source.y / info.height;
+        float bottom = (float) (source.y + source.h) / info.height;
+
+        if (command.flipped) {
+            std::swap(left, right);
+        }
+
+        SDL_Color color { 255, 255, 255, command.alpha };
+        float x = destination.x;
+        float y = destination.y;
+        float w = destination.w;
+        float h = destination.h;
+
+        int first = vertices.size();
+
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x, y }, color, SDL_FPoint { left, top } });
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x + w, y }, color, SDL_FPoint { right, top } });
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x + w, y + h }, color, SDL_FPoint { right, bottom } });
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x, y + h }, color, SDL_FPoint { left, bottom } });
+
+        for (int corner : { 0, 1, 2, 0, 2, 3 }) {
+            indices.push_back(first + corner);
+        }
+    }
+
+    submitBatch(batchTexture);
+    commands.clear();
+
+    // Textures can be destroyed between frames (and their addresses reused), so ids only last for a frame
+    textures.clear();
+}
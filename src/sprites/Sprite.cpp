@@ -47,4 +47,9 @@ void Sprite::setDepth(unsigned int newDepth) {
 // draws the sprite to the screen
 void Sprite::draw(SDL_Renderer* renderer) const {
     SDL_RenderCopy(renderer, sprite, &textureRect, &targetRect);
+}
+
+// queues the sprite, so it is layered by its depth when the queue is flushed
+void Sprite::draw(RenderQueue& queue) const {
+    queue.push(sprite, textureRect, targetRect, depth);
 }
\ No newline at end of file
@@ -1,12 +1,14 @@
 #include "sprites/Spritesheet.hpp"
 
 #include "sdlLogging.hpp"
+#include "ResourceCache.hpp"
 
 #include <iostream>
 #include <cassert>
 
 void Spritesheet::loadTexture() {
-    texture = IMG_LoadTexture(renderer, path.c_str());
+    cachedTexture = ResourceCache::getInstance()->getTexture(path);
+    texture = cachedTexture.get();
 
     if (texture == NULL) {
         sdlError("Could not load texture!");
@@ -17,42 +19,100 @@ void Spritesheet::loadTexture() {
 
 Spritesheet::Spritesheet(SDL_Renderer* _renderer, std::string _path, Vector2 _spriteSize, int _rows, int _columns) : renderer(_renderer), path(_path), spriteSize(_spriteSize), rows(_rows), columns(_columns) {}
 
-void Spritesheet::draw(int index, Vector2 position, bool flipped, float opacity) {
-    if (!hasLoadedTexture) {
-        loadTexture();
+bool Spritesheet::getSource(int index, bool& flipped, SDL_Rect& source) const {
+    if (usesAtlas) {
+        if (index < 0 || index >= (int) frames.size()) {
+            return false;
+        }
+
+        // Mirrored frames are already in the atlas, so no flip is needed
+        if (flipped && !flippedFrames.empty()) {
+            source = flippedFrames[index];
+            flipped = false;
+        } else {
+            source = frames[index];
+        }
+        return true;
     }
 
     int row = index / columns;
     int column = index % columns;
 
-    auto sourcePosition = SDL_Rect {
+    source = SDL_Rect {
         (int) (column * spriteSize.getX()),
         (int) (row * spriteSize.getY()),
         (int) spriteSize.getX(),
         (int) spriteSize.getY()
     };
+    return true;
+}
 
-    auto drawPosition = SDL_Rect {
+SDL_Rect Spritesheet::getDestination(const Vector2& position) const {
+    return SDL_Rect {
         (int) (position.getX() - spriteSize.getX() / 2),
         (int) (position.getY() - spriteSize.getY() / 2),
         (int) spriteSize.getX(),
         (int) spriteSize.getY()
     };
+}
+
+void Spritesheet::draw(int index, Vector2 position, bool flipped, float opacity) {
+    if (!hasLoadedTexture) {
+        loadTexture();
+    }
+
+    SDL_Rect sourcePosition;
+
+    if (!getSource(index, flipped, sourcePosition)) {
+        return;
+    }
+
+    auto drawPosition = getDestination(position);
     SDL_SetTextureAlphaMod(texture, opacity*255);
-    SDL_RenderCopyEx(renderer, texture, &sourcePosition, &drawPosition, 0, NULL, flipped ? SDL_FLIP_HORIZONTAL : SDL_FLIP_NONE);
+
+    if (flipped) {
+        SDL_RenderCopyEx(renderer, texture, &sourcePosition, &drawPosition, 0, NULL, SDL_FLIP_HORIZONTAL);
+    } else {
+        SDL_RenderCopy(renderer, texture, &sourcePosition, &drawPosition);
+    }
+}
+
+void Spritesheet::draw(RenderQueue& queue, unsigned int depth, int index, Vector2 position, bool flipped, float opacity) {
+    if (!hasLoadedTexture) {
+        loadTexture();
+    }
+
+    SDL_Rect sourcePosition;
+
+    if (getSource(index, flipped, sourcePosition)) {
+        queue.push(texture, sourcePosition, getDestination(position), depth, opacity * 255, flipped);
+    }
+}
+
+void Spritesheet::useAtlas(SDL_Texture* page, const std::vector<SDL_Rect>& _frames, const std::vector<SDL_Rect>& _flippedFrames, const std::vector<FrameCoverage>& _coverage) {
+    cachedTexture.reset();
+    texture = page;
+    hasLoadedTexture = true;
+    usesAtlas = true;
+    frames = _frames;
+    flippedFrames = _flippedFrames;
+    coverage = _coverage;
 }
 
 void Spritesheet::draw(int index, Vector2 position) {
     draw(index, position, false, 1.0);
 }
 
+void Spritesheet::setBlendMode(SDL_BlendMode blendMode) {
+    if (!hasLoadedTexture) {
+        loadTexture();
+    }
+
+    SDL_SetTextureBlendMode(texture, blendMode);
+}
+
 bool Spritesheet::containsID(uint32_t index) const {
     if(index>=firstGID && index<=lastGID){
         return true;
     } return false;
 }
-
-Spritesheet::~Spritesheet() {
-    if (texture != nullptr)
-        SDL_DestroyTexture(texture);
-}
\ No newline at end of file
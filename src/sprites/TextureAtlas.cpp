@@ -0,0 +1,277 @@
+#include "sprites/TextureAtlas.hpp"
+#include "ResourceCache.hpp"
+#include "TextureResidency.hpp"
+
+#include <iostream>
+#include <algorithm>
+#include <cstring>
+
+std::map<std::pair<SDL_Renderer*, std::string>, std::shared_ptr<TextureAtlas>> TextureAtlas::atlases;
+
+std::shared_ptr<TextureAtlas> TextureAtlas::get(SDL_Renderer* renderer, const std::string& name) {
+    auto& atlas = atlases[std::make_pair(renderer, name)];
+
+    if (!atlas) {
+        atlas = std::make_shared<TextureAtlas>();
+    }
+
+    return atlas;
+}
+
+void TextureAtlas::releaseAll() {
+    atlases.clear();
+}
+
+void TextureAtlas::add(Spritesheet& spritesheet, bool storeFlipped) {
+    Entry entry;
+    entry.spritesheet = &spritesheet;
+    entry.storeFlipped = storeFlipped;
+    entries.push_back(entry);
+}
+
+void TextureAtlas::place(int width, int height, int& page, int& x, int& y, std::vector<SDL_Rect>& shelves) {
+    // Each shelf is a row of a page, x and w being how far it is filled, and h its height
+    for (auto& shelf : shelves) {
+        if (height <= shelf.h && shelf.w + width <= ATLAS_PAGE_SIZE) {
+            page = shelf.x;
+            x = shelf.w;
+            y = shelf.y;
+            shelf.w += width;
+            return;
+        }
+    }
+
+    // Open a new shelf under the last one on the newest page, or on a new page
+    int newestPage = shelves.empty() ? -1 : shelves.back().x;
+    int nextY = shelves.empty() ? 0 : shelves.back().y + shelves.back().h;
+
+    if (newestPage == -1 || nextY + height > ATLAS_PAGE_SIZE) {
+        newestPage++;
+        nextY = 0;
+    }
+
+    shelves.push_back(SDL_Rect { newestPage, nextY, width, height });
+    page = newestPage;
+    x = 0;
+    y = nextY;
+}
+
+void TextureAtlas::copyFrames(SDL_Surface* source, SDL_Surface* page, const Entry& entry, int x, int y, bool flip) {
+    auto frameWidth = static_cast<int>(entry.spritesheet->getSpriteSize().getX());
+    auto bytes = static_cast<const Uint8*>(source->pixels);
+    auto pageBytes = static_cast<Uint8*>(page->pixels);
+
+    // Both surfaces are RGBA32, so a pixel is 4 bytes
+    for (int row = 0; row < entry.height; row++) {
+        auto sourceRow = reinterpret_cast<const Uint32*>(bytes + row * source->pitch);
+        auto pageRow = reinterpret_cast<Uint32*>(pageBytes + (y + row) * page->pitch) + x;
+
+        if (!flip) {
+            std::memcpy(pageRow, sourceRow, entry.width * 4);
+            continue;
+        }
+
+        for (int frameX = 0; frameX < entry.width; frameX += frameWidth) {
+            for (int column = 0; column < frameWidth; column++) {
+                pageRow[frameX + column] = sourceRow[frameX + frameWidth - 1 - column];
+            }
+        }
+    }
+}
+
+FrameCoverage TextureAtlas::measureCoverage(SDL_Surface* source, const SDL_Rect& frame) {
+    FrameCoverage coverage;
+    coverage.opaque = true;
+    coverage.empty = true;
+    coverage.solid = true;
+
+    auto bytes = static_cast<const Uint8*>(source->pixels);
+    auto first = bytes + frame.y * source->pitch + frame.x * 4;
+    coverage.color = SDL_Color { first[0], first[1], first[2], first[3] };
+
+    // RGBA32 stores the bytes of a pixel in R, G, B, A order
+    for (int y = frame.y; y < frame.y + frame.h; y++) {
+        auto pixel = bytes + y * source->pitch + frame.x * 4;
+
+        for (int x = 0; x < frame.w; x++, pixel += 4) {
+            coverage.opaque = coverage.opaque && pixel[3] == 255;
+            coverage.empty = coverage.empty && pixel[3] == 0;
+            coverage.solid = coverage.solid && std::memcmp(pixel, first, 4) == 0;
+        }
+    }
+
+    return coverage;
+}
+
+void TextureAtlas::build(SDL_Renderer* renderer) {
+    std::vector<SDL_Rect> shelves;
+
+    // Get the pixels of every sheet first (decoded once by the resource cache), so they can be packed tallest first
+    for (auto& entry : entries) {
+        auto spritesheet = entry.spritesheet;
+        entry.surface = ResourceCache::getInstance()->getSurface(spritesheet->getPath(), SDL_PIXELFORMAT_RGBA32);
+
+        if (entry.surface == nullptr) {
+            continue;
+        }
+
+        // Only the part of the image covered by whole frames is used
+        int frameWidth = spritesheet->getSpriteSize().getX();
+        int frameHeight = spritesheet->getSpriteSize().getY();
+        entry.width = std::min(spritesheet->getColumns(), entry.surface->w / frameWidth) * frameWidth;
+        entry.height = std::min(spritesheet->getRows(), entry.surface->h / frameHeight) * frameHeight;
+
+        if (entry.width <= 0 || entry.height <= 0 || entry.width > ATLAS_PAGE_SIZE || entry.height > ATLAS_PAGE_SIZE) {
+            entry.surface = nullptr;
+        }
+    }
+
+    std::vector<Entry*> order;
+
+    for (auto& entry : entries) {
+        if (entry.surface) {
+            order.push_back(&entry);
+        }
+    }
+
+    std::stable_sort(order.begin(), order.end(), [](const Entry* a, const Entry* b) {
+        return a->height > b->height;
+    });
+
+    int pageCount = 0;
+
+    for (auto entry : order) {
+        place(entry->width, entry->height, entry->page, entry->x, entry->y, shelves);
+
+        if (entry->storeFlipped) {
+            place(entry->width, entry->height, entry->flippedPage, entry->flippedX, entry->flippedY, shelves);
+        }
+
+        pageCount = std::max(pageCount, std::max(entry->page, entry->flippedPage) + 1);
+    }
+
+    // Pages are only as large as the shelves on them
+    std::vector<SDL_Surface*> surfaces;
+
+    for (int page = 0; page < pageCount; page++) {
+        int width = 0;
+        int height = 0;
+
+        for (auto& shelf : shelves) {
+            if (shelf.x == page) {
+                width = std::max(width, shelf.w);
+                height = std::max(height, shelf.y + shelf.h);
+            }
+        }
+
+        auto surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+
+        if (surface) {
+            SDL_FillRect(surface, NULL, 0);
+        }
+
+        surfaces.push_back(surface);
+    }
+
+    for (auto entry : order) {
+        if (surfaces[entry->page]) {
+            copyFrames(entry->surface.get(), surfaces[entry->page], *entry, entry->x, entry->y, false);
+        }
+
+        if (entry->storeFlipped && surfaces[entry->flippedPage]) {
+            copyFrames(entry->surface.get(), surfaces[entry->flippedPage], *entry, entry->flippedX, entry->flippedY, true);
+        }
+    }
+
+    size_t firstPage = pages.size();
+
+    for (auto surface : surfaces) {
+        SDL_Texture* texture = NULL;
+
+        if (surface) {
+            texture = SDL_CreateTextureFromSurface(renderer, surface);
+
+            // Pages are drawn from all the time, so they count towards the texture budget but are never freed
+            if (texture) {
+                TextureResidency::getInstance()->add(texture, (size_t) surface->w * surface->h * 4);
+            }
+
+            SDL_FreeSurface(surface);
+        }
+
+        if (texture) {
+            SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+        } else {
+            std::cerr << "Could not create atlas page: " << SDL_GetError() << std::endl;
+        }
+
+        pages.push_back(texture);
+    }
+
+    // Point every packed sheet at its frames
+    for (auto entry : order) {
+        auto page = pages[firstPage + entry->page];
+        bool hasFlipped = entry->storeFlipped && page == pages[firstPage + entry->flippedPage];
+
+        if (page) {
+            auto spritesheet = entry->spritesheet;
+            int frameWidth = spritesheet->getSpriteSize().getX();
+            int frameHeight = spritesheet->getSpriteSize().getY();
+
+            std::vector<SDL_Rect> frames;
+            std::vector<SDL_Rect> flippedFrames;
+            std::vector<FrameCoverage> coverage;
+
+            for (int row = 0; row < spritesheet->getRows(); row++) {
+                for (int column = 0; column < spritesheet->getColumns(); column++) {
+                    // Frames past the edge of the image are empty, like they were in the sheet's own texture
+                    if ((column + 1) * frameWidth > entry->width || (row + 1) * frameHeight > entry->height) {
+                        frames.push_back(SDL_Rect { 0, 0, 0, 0 });
+                        flippedFrames.push_back(SDL_Rect { 0, 0, 0, 0 });
+                        coverage.emplace_back();
+                        coverage.back().empty = true;
+                        continue;
+                    }
+
+                    coverage.push_back(measureCoverage(entry->surface.get(), SDL_Rect { column * frameWidth, row * frameHeight, frameWidth, frameHeight }));
+
+                    frames.push_back(SDL_Rect { entry->x + column * frameWidth, entry->y + row * frameHeight, frameWidth, frameHeight });
+
+                    if (hasFlipped) {
+                        flippedFrames.push_back(SDL_Rect { entry->flippedX + column * frameWidth, entry->flippedY + row * frameHeight, frameWidth, frameHeight });
+                    }
+                }
+            }
+
+            if (!hasFlipped) {
+                flippedFrames.clear();
+            }
+
+            placements[spritesheet->getPath()] = Placement { page, frames, flippedFrames, coverage };
+            apply(*spritesheet);
+        }
+    }
+
+    entries.clear();
+}
+
+bool TextureAtlas::apply(Spritesheet& spritesheet) const {
+    auto found = placements.find(spritesheet.getPath());
+
+    if (found == placements.end()) {
+        return false;
+    }
+
+    auto& placement = found->second;
+    spritesheet.useAtlas(placement.page, placement.frames, placement.flippedFrames, placement.coverage);
+    return true;
+}
+
+TextureAtlas::~TextureAtlas() {
+    for (auto page : pages) {
+        if (page != nullptr) {
+            TextureResidency::getInstance()->remove(page);
+            SDL_DestroyTexture(page);
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#include "ui/GlyphAtlas.hpp"
+
+#include "sdlLogging.hpp"
+
+#include <iostream>
+
+std::map<std::tuple<SDL_Renderer*, TTF_Font*, int>, std::shared_ptr<GlyphAtlas>> GlyphAtlas::atlases;
+
+std::shared_ptr<GlyphAtlas> GlyphAtlas::get(SDL_Renderer* renderer, TTF_Font* font, int pixelSize) {
+    auto& atlas = atlases[std::make_tuple(renderer, font, pixelSize)];
+
+    if (!atlas) {
+        atlas = std::make_shared<GlyphAtlas>(renderer, font, pixelSize);
+    }
+
+    return atlas;
+}
+
+void GlyphAtlas::releaseAll() {
+    atlases.clear();
+}
+
+void GlyphAtlas::build() {
+    SDL_Surface* surfaces[LAST_GLYPH - FIRST_GLYPH + 1] = {};
+    SDL_Color white = { 255, 255, 255, 255 };
+
+    // Atlases share the font and only render with it here, so each one sets the size it needs first.
+    // If the size can't be changed the glyphs keep the size the font was opened at, and text scales them.
+    if (TTF_SetFontSize(font, pixelSize) != 0) {
+        std::cerr << "Could not set font size to " << pixelSize << ": " << TTF_GetError() << std::endl;
+    }
+
+    lineHeight = TTF_FontHeight(font);
+
+    // Lay the glyphs out in rows (every glyph is a line tall)
+    int x = 0;
+    int y = 0;
+
+    for (int character = FIRST_GLYPH; character <= LAST_GLYPH; character++) {
+        auto& glyph = glyphs[character - FIRST_GLYPH];
+        int minX, maxX, minY, maxY;
+
+        if (TTF_GlyphMetrics(font, character, &minX, &maxX, &minY, &maxY, &glyph.advance) != 0) {
+            continue;
+        }
+
+        auto surface = TTF_RenderGlyph_Blended(font, character, white);
+
+        if (surface == NULL) {
+            continue;
+        }
+
+        if (x + surface->w > GLYPH_ATLAS_WIDTH) {
+            x = 0;
+            y += lineHeight;
+        }
+
+        surfaces[character - FIRST_GLYPH] = surface;
+        glyph.source = SDL_Rect { x, y, surface->w, surface->h };
+        glyph.present = true;
+
+        x += surface->w;
+    }
+
+    auto page = SDL_CreateRGBSurfaceWithFormat(0, GLYPH_ATLAS_WIDTH, y + lineHeight, 32, SDL_PIXELFORMAT_RGBA32);
+
+    if (page == NULL)
+        sdlError("Could not create glyph atlas surface!");
+
+    // Copy the glyphs as they are (alpha included) rather than blending them onto the empty page
+    for (int i = 0; i <= LAST_GLYPH - FIRST_GLYPH; i++) {
+        if (surfaces[i] == NULL) {
+            continue;
+        }
+
+        // SDL_BlitSurface writes the clipped rectangle back, so it gets a copy
+        auto destination = glyphs[i].source;
+
+        SDL_SetSurfaceBlendMode(surfaces[i], SDL_BLENDMODE_NONE);
+        SDL_BlitSurface(surfaces[i], NULL, page, &destination);
+        SDL_FreeSurface(surfaces[i]);
+    }
+
+    texture = SDL_CreateTextureFromSurface(renderer, page);
+    SDL_FreeSurface(page);
+
+    if (texture == NULL)
+        sdlError("Could not create glyph atlas texture!");
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+}
+
+const Glyph* GlyphAtlas::getGlyph(char character) const {
+    int index = static_cast<unsigned char>(character) - FIRST_GLYPH;
+
+    if (index < 0 || index > LAST_GLYPH - FIRST_GLYPH || !glyphs[index].present) {
+        return nullptr;
+    }
+
+    return &glyphs[index];
+}
+
+GlyphAtlas::~GlyphAtlas() {
+    if (texture != nullptr)
+        SDL_DestroyTexture(texture);
+}
@@ -0,0 +1,75 @@
+#include "ui/PrimitiveCache.hpp"
+
+#include <iostream>
+
+std::map<std::pair<SDL_Renderer*, int>, SDL_Texture*> PrimitiveCache::circles;
+
+SDL_Texture* PrimitiveCache::createCircle(SDL_Renderer* renderer, int radius) {
+    int size = radius * 2;
+    auto surface = SDL_CreateRGBSurfaceWithFormat(0, size, size, 32, SDL_PIXELFORMAT_RGBA32);
+
+    if (surface == NULL) {
+        std::cerr << "Could not create circle surface: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    SDL_LockSurface(surface);
+
+    for (int j = 0; j < size; j++) {
+        auto pixel = static_cast<Uint8*>(surface->pixels) + j * surface->pitch;
+
+        for (int i = 0; i < size; i++, pixel += 4) {
+            int dx = i - radius + 1;
+            int dy = j - radius + 1;
+            Uint8 value = dx * dx + dy * dy <= radius * radius ? 255 : 0;
+
+            // RGBA32 stores the bytes of a pixel in R, G, B, A order
+            pixel[0] = 255;
+            pixel[1] = 255;
+            pixel[2] = 255;
+            pixel[3] = value;
+        }
+    }
+
+    SDL_UnlockSurface(surface);
+
+    auto texture = SDL_CreateTextureFromSurface(renderer, surface);
+    SDL_FreeSurface(surface);
+
+    if (texture == NULL) {
+        std::cerr << "Could not create circle texture: " << SDL_GetError() << std::endl;
+        return nullptr;
+    }
+
+    SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+    return texture;
+}
+
+SDL_Texture* PrimitiveCache::getCircle(SDL_Renderer* renderer, int radius) {
+    if (radius <= 0) {
+        return nullptr;
+    }
+
+    auto key = std::make_pair(renderer, radius);
+    auto found = circles.find(key);
+
+    if (found != circles.end()) {
+        return found->second;
+    }
+
+    auto texture = createCircle(renderer, radius);
+
+    // Failures are cached too, so they aren't retried every frame
+    circles[key] = texture;
+    return texture;
+}
+
+void PrimitiveCache::releaseAll() {
+    for (auto& circle : circles) {
+        if (circle.second != nullptr) {
+            SDL_DestroyTexture(circle.second);
+        }
+    }
+
+    circles.clear();
+}
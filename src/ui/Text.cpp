@@ -1,63 +1,102 @@
 #include "ui/Text.hpp"
 
-#include "sdlLogging.hpp"
+#include <iostream>
+#include <cmath>
 
-void Text::generateTexture() {
-    SDL_Surface* textSurface = TTF_RenderText_Solid(font, text.c_str(), color);
-    
-    if (textSurface == NULL)
-        ttfError("Could not create text surface!");
+void Text::layout() {
+    if (atlas == nullptr) {
+        atlas = GlyphAtlas::get(renderer, font, (int) std::round(fontSize));
+    }
+
+    vertices.clear();
+    indices.clear();
+
+    // Glyphs are rasterized at fontSize, this only corrects for lines of the font being a little taller or shorter than that
+    double ratio = fontSize / atlas->getLineHeight();
+
+    int width = 0;
+
+    for (char character : text) {
+        auto glyph = atlas->getGlyph(character);
+
+        if (glyph != nullptr) {
+            width += glyph->advance;
+        }
+    }
+
+    int textureWidth, textureHeight;
+    SDL_QueryTexture(atlas->getTexture(), NULL, NULL, &textureWidth, &textureHeight);
+
+    // Start from the top left so the text is centered around the position
+    int left = (int) (position.getX() - width * ratio / 2);
+    int top = (int) (position.getY() - fontSize / 2);
+    int penX = 0;
 
-    SDL_Texture* texture = SDL_CreateTextureFromSurface(renderer, textSurface); // This line seems to cause the
+    for (char character : text) {
+        auto glyph = atlas->getGlyph(character);
 
-    if (texture == NULL)
-        sdlError("Could not create texture!");
+        if (glyph == nullptr) {
+            continue;
+        }
 
-    SDL_FreeSurface(textSurface);
+        auto& source = glyph->source;
 
-    generatedTexture = texture;
+        float x0 = left + penX * ratio;
+        float x1 = x0 + source.w * ratio;
+        float y0 = top;
+        float y1 = top + source.h * ratio;
 
-    // Calculate the size of the rendered text (this seems to work)
-    int w, h;
+        float u0 = (float) source.x / textureWidth;
+        float u1 = (float) (source.x + source.w) / textureWidth;
+        float v0 = (float) source.y / textureHeight;
+        float v1 = (float) (source.y + source.h) / textureHeight;
 
-    TTF_SizeText(font, text.c_str(), &w, &h);
+        int first = vertices.size();
 
-    double ratio = (double) fontSize / h;
-    double width = (double) w * ratio;
-    double height = (double) h * ratio;
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x0, y0 }, color, SDL_FPoint { u0, v0 } });
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x1, y0 }, color, SDL_FPoint { u1, v0 } });
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x1, y1 }, color, SDL_FPoint { u1, v1 } });
+        vertices.push_back(SDL_Vertex { SDL_FPoint { x0, y1 }, color, SDL_FPoint { u0, v1 } });
 
-    renderedSize = Vector2(width, height);
+        for (int corner : { 0, 1, 2, 0, 2, 3 }) {
+            indices.push_back(first + corner);
+        }
+
+        penX += glyph->advance;
+    }
+
+    needsLayout = false;
 }
 
 void Text::draw() {
-    if (generatedTexture == nullptr) {
-        generateTexture();
+    if (needsLayout) {
+        layout();
     }
 
-    double width = renderedSize.getX();
-    double height = renderedSize.getY();
-
-    SDL_Rect location = {(int) (position.getX() - width / 2), (int) (position.getY() - height / 2), (int) width, (int) height};
+    if (indices.empty()) {
+        return;
+    }
 
-    SDL_RenderCopy(renderer, generatedTexture, NULL, &location);
+    if (SDL_RenderGeometry(renderer, atlas->getTexture(), vertices.data(), vertices.size(), indices.data(), indices.size()) != 0) {
+        std::cerr << "Could not draw text: " << SDL_GetError() << std::endl;
+    }
 }
 
 void Text::setText(const std::string& _text) {
-    // Only re-generate the texture if it is different
+    // Only lay the text out again if it is different
     if (text != _text) {
         text = _text;
-        generateTexture();
+        needsLayout = true;
     }
 }
 
 void Text::setColor(SDL_Color _color) {
     if (color.r != _color.r || color.g != _color.g || color.b != _color.b || color.a != _color.a) {
         color = _color;
-        generateTexture();
+
+        // The glyphs are white, so the colour is just the vertex colour
+        for (auto& vertex : vertices) {
+            vertex.color = color;
+        }
     }
 }
-
-Text::~Text() {
-    if (generatedTexture != nullptr)
-        SDL_DestroyTexture(generatedTexture);
-}
\ No newline at end of file
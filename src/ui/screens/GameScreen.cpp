@@ -11,6 +11,7 @@
 #include "SDL2_gfxPrimitives.h"
 
 #include <iostream>
+#include <cmath>
 
 // Helper functions for if a key is pressed
 bool isMoveLeftPressed(const Uint8* keysPressed) {
@@ -29,45 +30,87 @@ bool isJumpPressed(const Uint8* keysPressed) {
 
 
 void GameScreen::drawLevel(std::shared_ptr<Level> level) {
+    auto& chunks = level->getTileChunks();
+
+    if (chunks.isBaked()) {
+        chunks.draw(scrollOffset, alpha);
+
+        // Hitbox tiles aren't part of the chunks, so they can be toggled
+        if (showHitboxes) {
+            drawTiles(level, true);
+        }
+    } else {
+        drawTiles(level, false);
+    }
+}
+
+void GameScreen::drawTiles(std::shared_ptr<Level> level, bool hitboxesOnly) {
+    // Only the columns on screen (plus a tile on each side for partly visible ones)
+    int firstColumn = static_cast<int>(floor(scrollOffset / TILE_SIZE)) - 1;
+    int lastColumn = static_cast<int>(floor((scrollOffset + WINDOW_WIDTH) / TILE_SIZE)) + 1;
+
     for (const auto& layer : level->getLayers()) {
+        if (layer->hasFill() && !hitboxesOnly) {
+            auto color = layer->getFillColor();
+
+            SDL_BlendMode previousBlendMode;
+            SDL_GetRenderDrawBlendMode(renderer, &previousBlendMode);
+
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_BLEND);
+            SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a * layer->getOpacity() * alpha);
+            SDL_RenderFillRect(renderer, NULL);
+            SDL_SetRenderDrawBlendMode(renderer, previousBlendMode);
+        }
+
         auto& blocks = layer->getBlocks();
+        auto range = layer->getBlocksInColumns(firstColumn, lastColumn);
 
-        for (auto i = 0; i < blocks.size(); i++) {
+        for (auto it = range.first; it != range.second; it++) {
+            int i = *it;
             auto& blockEntry = blocks[i];
             auto block = std::get<0>(blockEntry);
             // auto block = blocks[0];
             auto flip = std::get<1>(blockEntry);
 
             uint32_t tileID = layer->getID(i);
-            auto t = layer->hasFlipFlag(i);
-
-            if(t){std::cout<<"got tile "<<tileID<<"flip flag? "<<t<<std::endl;}
+            auto& info = level->getTileInfo(tileID);
             auto opacity = layer->getOpacity();
-
+            bool isHitbox = (info.flags & TILE_HITBOX) != 0;
 
             // Quit out if hitboxes are not being shown and the given tile is a hitbox tile
-            if (!showHitboxes && level->isHitboxGID(tileID)) {
+            if (!showHitboxes && isHitbox) {
                 continue;
             }
 
-            std::shared_ptr<Spritesheet> spritesheet = level->getSpritesheetForGID(tileID);
+            if (hitboxesOnly && !isHitbox) {
+                continue;
+            }
 
-            if (!spritesheet) {
+            if (info.spritesheet < 0) {
                 std::cerr << "No spritesheet found for tile ID: " << tileID << std::endl;
                 continue;
             }
 
+            auto& spritesheet = level->getSpritesheets()[info.spritesheet];
+
             auto drawOffset = TILE_SIZE / 2;
 
             Vector2 blockPosition(block.getX() * TILE_SIZE - scrollOffset + drawOffset, block.getY() * TILE_SIZE + drawOffset);
-            int spriteIndex = tileID - spritesheet->getFirstGID();
-
-            spritesheet->draw(spriteIndex, blockPosition, flip, opacity * alpha);
+            spritesheet->draw(info.spriteIndex, blockPosition, flip, opacity * alpha);
         }
     }
 }
 
+bool GameScreen::isOnScreen(const Vector2& position, double width) const {
+    return position.getX() + width / 2 >= scrollOffset && position.getX() - width / 2 <= scrollOffset + WINDOW_WIDTH;
+}
+
 void GameScreen::drawCollisionHitbox(const Vector2& position, const BoundingBox& hitbox) const {
+    if (!isOnScreen(position + hitbox.getOffset() + hitbox.getSize() / 2, hitbox.getSize().getX())) {
+        return;
+    }
+
+
     boxRGBA(renderer, position.getX() - scrollOffset + hitbox.getLeftX(), position.getY() + hitbox.getTopY(), position.getX() - scrollOffset + hitbox.getRightX(), position.getY() + hitbox.getBottomY(), 0, 255, 0, 100);
 }
 
@@ -94,10 +137,8 @@ void GameScreen::draw() {
 
     // Draw a box for the player
     auto player = gameLogic.getPlayer();
-    Vector2 playerPosition = player->getPosition();
-
-    // Get the enemies and their positions
-    auto enemies = gameLogic.getLevel()->getEnemies();
+    double interpolation = gameLogic.getInterpolation();
+    Vector2 playerPosition = player->getInterpolatedPosition(interpolation);
 
     // Calculate the scroll offset
     scrollOffset = gameLogic.getScrollOffset();
@@ -106,66 +147,99 @@ void GameScreen::draw() {
     PlayerTexture playerTexture = PlayerTexture::WALK1;
     auto level = gameLogic.getLevel();
 
+    // Get the enemies and their positions
+    auto& enemies = level->getEnemies();
+    auto& corgis = level->getCorgis();
+    auto& powerups = level->getPowerups();
+    auto& projectiles = level->getProjectiles();
+
     drawLevel(level);
 
-    playerSprite.draw(PlayerTexture::WALK1 + player->getCurrentAnimationOffset(), playerPosition - Vector2(scrollOffset, 0), player->getLastDirection() == MoveDirection::LEFT, alpha);
+    playerSprite.draw(renderQueue, DEPTH_PLAYER, PlayerTexture::WALK1 + player->getCurrentAnimationOffset(), playerPosition - Vector2(scrollOffset, 0), player->getLastDirection() == MoveDirection::LEFT, alpha);
 
-    for (auto enemy : enemies) {
-        Vector2 enemyPosition = enemy->getPosition();
-        if (enemy->isEnemyBiker()){enemybikeSprite.draw(BikerEnemyTexture::BIKER1 + enemy->getBikerAnimationOffset(), enemyPosition-Vector2(scrollOffset, 0), enemy->getLastDirection() == MoveDirection::RIGHT, alpha);}
-        else {enemySprite.draw(EnemyTexture::ENEMY1WALK1 + enemy->getCurrentAnimationOffset(), enemyPosition - Vector2(scrollOffset, 0), enemy->getLastDirection() == MoveDirection::RIGHT, alpha);}
-        
-        //draw enemy projectiles
-        for (auto proj : enemy->getProjectiles()) {
-            Vector2 enemyProjectilePosition = proj.getPosition();;
-            if (proj.isMovingLeft()) {
-                playerProjectileSprite.draw(2, enemyProjectilePosition - Vector2(scrollOffset, 0), false, alpha);
-            }
-            else {
-                playerProjectileSprite.draw(2, enemyProjectilePosition - Vector2(scrollOffset, 0), true, alpha);
-            }
+    for (size_t idx = 0; idx < enemies.size(); idx++) {
+        auto enemy = level->getEnemy(idx);
+        Vector2 enemyPosition = enemy.getInterpolatedPosition(interpolation);
+
+        if (!isOnScreen(enemyPosition, BIKER_WIDTH)) {
+            continue;
         }
+
+        if (enemy.isEnemyBiker()){enemybikeSprite.draw(renderQueue, DEPTH_ENEMIES, BikerEnemyTexture::BIKER1 + enemy.getBikerAnimationOffset(), enemyPosition-Vector2(scrollOffset, 0), enemy.getLastDirection() == MoveDirection::RIGHT, alpha);}
+        else {enemySprite.draw(renderQueue, DEPTH_ENEMIES, EnemyTexture::ENEMY1WALK1 + enemy.getCurrentAnimationOffset(), enemyPosition - Vector2(scrollOffset, 0), enemy.getLastDirection() == MoveDirection::RIGHT, alpha);}
     }
 
-    for (auto corgi : level->getCorgis()) {
-        Vector2 corgiPosition = corgi->getPosition();
-        corgiSprite.draw(CorgiTexture::CORGI1WALK1 + corgi->getCurrentAnimationOffset(), corgiPosition - Vector2(scrollOffset, 0), corgi->getLastDirection() == MoveDirection::RIGHT, alpha);
+    for (size_t idx = 0; idx < corgis.size(); idx++) {
+        auto corgi = level->getCorgi(idx);
+        Vector2 corgiPosition = corgi.getInterpolatedPosition(interpolation);
+
+        if (!isOnScreen(corgiPosition, CORGI_WIDTH)) {
+            continue;
+        }
+
+        corgiSprite.draw(renderQueue, DEPTH_CORGIS, CorgiTexture::CORGI1WALK1 + corgi.getCurrentAnimationOffset(), corgiPosition - Vector2(scrollOffset, 0), corgi.getLastDirection() == MoveDirection::RIGHT, alpha);
     }
-    for (auto powerup : level->getPowerups()) {
-        Vector2 powerupPosition = powerup->getPosition();
-        powerupSprite.draw(PowerupTexture::COFFEE5 + powerup->getCurrentAnimationOffset(), powerupPosition - Vector2(scrollOffset, 0), powerup->getLastDirection() == MoveDirection::RIGHT, alpha);
+    for (size_t idx = 0; idx < powerups.size(); idx++) {
+        auto powerup = level->getPowerup(idx);
+        Vector2 powerupPosition = powerup.getInterpolatedPosition(interpolation);
+
+        if (!isOnScreen(powerupPosition, POWERUP_WIDTH)) {
+            continue;
+        }
+
+        powerupSprite.draw(renderQueue, DEPTH_POWERUPS, PowerupTexture::COFFEE5 + powerup.getCurrentAnimationOffset(), powerupPosition - Vector2(scrollOffset, 0), powerup.getLastDirection() == MoveDirection::RIGHT, alpha);
     }
 
+    // Display the projectiles that have been shot (enemy projectiles use a different sprite)
+    for (size_t idx = 0; idx < projectiles.size(); idx++) {
+        auto& proj = projectiles[idx];
+        Vector2 projectilePosition = proj.getInterpolatedPosition(interpolation);
+
+        if (!isOnScreen(projectilePosition, TILE_SIZE)) {
+            continue;
+        }
+
+        int sprite = proj.getOwner() == ProjectileOwner::PLAYER ? 3 : 2;
+        //boxRGBA(renderer, projectilePosition.getX() - 10 - scrollOffset, projectilePosition.getY() - 10, projectilePosition.getX() + 10 - scrollOffset, projectilePosition.getY() + 10, 0, 255, 255, 255);
+        playerProjectileSprite.draw(renderQueue, DEPTH_PROJECTILES, sprite, projectilePosition - Vector2(scrollOffset, 0), !proj.isMovingLeft(), alpha);
+    }
+
+    // Sprites are layered by depth and batched by texture
+    renderQueue.flush();
+
     // Draw the player hitbox + enemy hitboxes
     if (showHitboxes && !gameLogic.isLevelFinished()) {
-        drawCollisionHitbox(playerPosition, player->getHitbox());
+        // World colliders, after neighbouring tiles were merged
+        for (const auto& collider : level->getMergedColliders()) {
+            auto& bounds = collider.bounds;
 
-        for (auto enemy : enemies) {
-            drawCollisionHitbox(enemy->getPosition(), enemy->getHitbox());
-        }
+            if (bounds.x + bounds.w < scrollOffset || bounds.x > scrollOffset + WINDOW_WIDTH) {
+                continue;
+            }
 
-        for (auto corgi : level->getCorgis()) {
-            drawCollisionHitbox(corgi->getPosition(), corgi->getHitbox());
+            boxRGBA(renderer, bounds.x - scrollOffset, bounds.y, bounds.x + bounds.w - scrollOffset, bounds.y + bounds.h, 0, 0, 255, 60);
         }
 
-        for (auto powerup : level->getPowerups()) {
-            drawCollisionHitbox(powerup->getPosition(), powerup->getHitbox());
+        drawCollisionHitbox(playerPosition, player->getHitbox());
+
+        for (size_t idx = 0; idx < enemies.size(); idx++) {
+            auto enemy = level->getEnemy(idx);
+            drawCollisionHitbox(enemy.getInterpolatedPosition(interpolation), enemy.getHitbox());
         }
 
-        for (auto projectile : player->getProjectiles()) {
-            drawCollisionHitbox(projectile.getPosition(), projectile.getHitbox());
+        for (size_t idx = 0; idx < corgis.size(); idx++) {
+            auto corgi = level->getCorgi(idx);
+            drawCollisionHitbox(corgi.getInterpolatedPosition(interpolation), corgi.getHitbox());
         }
-    }
 
-    // Display the projectiles that have been shot
-    for (auto proj : player->getProjectiles()) {
-        Vector2 projectilePosition = proj.getPosition();
-        //boxRGBA(renderer, projectilePosition.getX() - 10 - scrollOffset, projectilePosition.getY() - 10, projectilePosition.getX() + 10 - scrollOffset, projectilePosition.getY() + 10, 0, 255, 255, 255);
-        if (proj.getVelocity().getX() < 0) {
-            playerProjectileSprite.draw(3, projectilePosition - Vector2(scrollOffset, 0), false, alpha);
+        for (size_t idx = 0; idx < powerups.size(); idx++) {
+            auto powerup = level->getPowerup(idx);
+            drawCollisionHitbox(powerup.getInterpolatedPosition(interpolation), powerup.getHitbox());
         }
-        else {
-            playerProjectileSprite.draw(3, projectilePosition - Vector2(scrollOffset, 0), true, alpha);
+
+        for (size_t idx = 0; idx < projectiles.size(); idx++) {
+            auto& projectile = projectiles[idx];
+            drawCollisionHitbox(projectile.getInterpolatedPosition(interpolation), projectile.getHitbox());
         }
     }
 
@@ -9,11 +9,9 @@ LevelSelectScreen::LevelSelectScreen(GameLogic& _gameLogic, SDL_Renderer* _rende
     levelSelect(_renderer, _font, Vector2(512, 70), 50, {255, 255, 255, 255}, "Level Select"),
     back(_renderer, _font, Vector2(512, 700), 30, {0, 0, 0, 255}, "Back"),
     levelsUnlocked(mathutils::clamp(levelsCompleted + 1, 1, 5)) {
-    levelTexts.push_back(Text(_renderer, _font, Vector2(512, 200), 40, {0, 0, 0, 255}, "Monday"));
-    levelTexts.push_back(Text(_renderer, _font, Vector2(512, 300), 40, {0, 0, 0, 255}, "Tuesday"));
-    levelTexts.push_back(Text(_renderer, _font, Vector2(512, 400), 40, {0, 0, 0, 255}, "Wednesday"));
-    levelTexts.push_back(Text(_renderer, _font, Vector2(512, 500), 40, {0, 0, 0, 255}, "Thursday"));
-    levelTexts.push_back(Text(_renderer, _font, Vector2(512, 600), 40, {0, 0, 0, 255}, "Friday"));
+    for (int i = 0; i < 5; i++) {
+        levelTexts.push_back(Text(_renderer, _font, Vector2(512, 200 + i * 100), 40, {0, 0, 0, 255}, levelNames[i]));
+    }
     SoundManager::getInstance()->playMusic(MusicTrack::TITLE_THEME);
 }
 
@@ -27,23 +25,24 @@ void LevelSelectScreen::draw() {
 
     levelSelect.draw();
 
-    //initialize this to something arbitrary so we dont have to call a constructor
-    Text currentText = levelTexts[0];
     SDL_Color buttonColor;
     SDL_Color defaultColor = {147, 115, 64, 255}; // Default color for buttons
     SDL_Color lockedColor = {111, 94, 68, 255}; // Locked color for buttons
     SDL_Color highlightedColor = {207, 171, 112, 255}; // Highlighted color for buttons
 
     for (int i = 0; i < 5; i++) {
-        currentText = levelTexts[i];
+        auto& currentText = levelTexts[i];
+
+        // The texts are only laid out again when the cursor moves onto or off of them
         if (levelsUnlocked <= i) {
             buttonColor = lockedColor;
+            currentText.setText(levelNames[i]);
         } else if (cursorPosition == i) {
             buttonColor = highlightedColor;
-            currentText.setText(">" + levelTexts[i].getText() + "<");
+            currentText.setText(">" + levelNames[i] + "<");
         } else {
             buttonColor = defaultColor;
-            currentText.setText(levelTexts[i].getText());
+            currentText.setText(levelNames[i]);
         }
 
         drawButton(512 - 225, 160 + i * 100, 450, 75, buttonColor);
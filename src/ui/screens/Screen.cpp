@@ -1,4 +1,6 @@
 #include "ui/screens/Screen.hpp"
+#include "ui/PrimitiveCache.hpp"
+#include "ResourceCache.hpp"
 
 void Screen::drawButton(int x, int y, int width, int height, SDL_Color color) {
     // Set the color for the button
@@ -17,35 +19,32 @@ void Screen::drawButton(int x, int y, int width, int height, SDL_Color color) {
 }
 
 void Screen::drawCircle(int cx, int cy, int radius) {
-    for (int w = 0; w < radius * 2; w++) {
-        for (int h = 0; h < radius * 2; h++) {
-            int dx = radius - w; // Horizontal offset
-            int dy = radius - h; // Vertical offset
-            if ((dx * dx + dy * dy) <= (radius * radius)) {
-                SDL_RenderDrawPoint(renderer, cx + dx, cy + dy);
-            }
-        }
+    auto circle = PrimitiveCache::getCircle(renderer, radius);
+
+    if (circle == nullptr) {
+        return;
     }
+
+    // Tint the cached circle with the current draw colour
+    Uint8 r, g, b, a;
+    SDL_GetRenderDrawColor(renderer, &r, &g, &b, &a);
+    SDL_SetTextureColorMod(circle, r, g, b);
+    SDL_SetTextureAlphaMod(circle, a);
+
+    SDL_Rect location = {cx - radius + 1, cy - radius + 1, radius * 2, radius * 2};
+    SDL_RenderCopy(renderer, circle, NULL, &location);
 }
 
 void Screen::drawBackground(std::string imagePath) {
-    // only load the image if it hasn't been loaded yet
+    // Backgrounds are shared through the resource cache, so switching screens doesn't load them again
     if (!background) {
-        SDL_Surface* surface = IMG_Load(imagePath.c_str());
-        if (!surface) {
-            std::cerr << "Failed to load image: " << IMG_GetError() << std::endl;
-        }
-    
-        background = SDL_CreateTextureFromSurface(renderer, surface);
-        SDL_FreeSurface(surface);
-    
-        if (!background) {
-            std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
-        }
+        background = ResourceCache::getInstance()->getTexture(imagePath);
     }
-    // Render to the screen
-    SDL_RenderCopy(renderer, background, NULL, NULL);
 
+    if (background) {
+        // Render to the screen
+        SDL_RenderCopy(renderer, background.get(), NULL, NULL);
+    }
 }
 
 Screen::~Screen() {}
\ No newline at end of file